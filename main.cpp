@@ -3,5 +3,9 @@
 int main(int argc, char *argv[]) {
     auto app = Gtk::Application::create(argc, argv, "org.example.osystem");
     MainWindow window;
-    return app->run(window);
+    // Comparte la tabla de frames con la CLI y otras instancias de la GUI
+    attachSharedMemory();
+    int status = app->run(window);
+    detachSharedMemory();
+    return status;
 }
\ No newline at end of file
@@ -0,0 +1,131 @@
+#ifndef MEMORY_GEOMETRY_H
+#define MEMORY_GEOMETRY_H
+
+#include <cstdint>
+#include <utility>
+
+// Dirección virtual separada en segmento, página y desplazamiento. La página es el índice
+// dentro del segmento desde 0 (en las tablas de páginas se numeran desde 1).
+struct VirtualAddress {
+    uint32_t segment;
+    uint32_t page;
+    uint32_t offset;
+};
+
+namespace geometry_detail {
+constexpr uint32_t log2Floor(uint64_t value) { return value <= 1 ? 0 : 1 + log2Floor(value >> 1); }
+constexpr uint32_t log2Ceil(uint64_t value) { return value <= 1 ? 0 : 1 + log2Floor(value - 1); }
+constexpr bool isPowerOfTwo(uint64_t value) { return value != 0 && (value & (value - 1)) == 0; }
+}
+
+// Geometría fija en compilación. La dirección es [segmento | desplazamiento en el segmento]
+// y el desplazamiento en el segmento ocupa los bits justos para 2^PageBits páginas.
+// Con páginas potencia de 2 separar una dirección son solo desplazamientos y máscaras; con
+// otros tamaños (como las páginas de 50 caracteres) la división es por una constante y el
+// compilador la cambia por una multiplicación.
+template <uint32_t PageSize, uint32_t PageBits>
+struct MemoryGeometry {
+    static_assert(PageSize > 0, "El tamaño de página debe ser positivo");
+    static_assert(PageBits < 32, "Demasiados bits de página");
+
+    static constexpr uint32_t page_size = PageSize;
+    static constexpr uint32_t page_bits = PageBits;
+    static constexpr uint64_t segment_span = static_cast<uint64_t>(PageSize) << PageBits;
+    static constexpr uint32_t linear_bits = geometry_detail::log2Ceil(segment_span);
+    static constexpr uint64_t linear_mask = (static_cast<uint64_t>(1) << linear_bits) - 1;
+
+    static constexpr VirtualAddress split(uint64_t address)
+    {
+        const uint64_t linear = address & linear_mask;
+        if constexpr (geometry_detail::isPowerOfTwo(PageSize))
+        {
+            constexpr uint32_t offsetBits = geometry_detail::log2Floor(PageSize);
+            return {static_cast<uint32_t>(address >> linear_bits), static_cast<uint32_t>(linear >> offsetBits),
+                    static_cast<uint32_t>(linear & (PageSize - 1))};
+        }
+        else
+        {
+            const uint64_t page = linear / PageSize;
+            return {static_cast<uint32_t>(address >> linear_bits), static_cast<uint32_t>(page),
+                    static_cast<uint32_t>(linear - page * PageSize)};
+        }
+    }
+
+    static constexpr uint64_t join(uint32_t segment, uint32_t page, uint32_t offset)
+    {
+        return (static_cast<uint64_t>(segment) << linear_bits) | (static_cast<uint64_t>(page) * PageSize + offset);
+    }
+
+    // Con páginas que no son potencia de 2 quedan desplazamientos sin página al final del segmento
+    static constexpr bool valid(uint64_t address) { return (address & linear_mask) < segment_span; }
+};
+
+// Geometría elegida en ejecución: mismas operaciones, pero con divisiones por variables
+class GenericGeometry {
+public:
+    GenericGeometry(uint32_t pageSize, uint32_t pageBits)
+        : page_size(pageSize),
+          segment_span(static_cast<uint64_t>(pageSize) << pageBits),
+          linear_bits(geometry_detail::log2Ceil(segment_span)),
+          linear_mask((static_cast<uint64_t>(1) << linear_bits) - 1) {}
+
+    VirtualAddress split(uint64_t address) const
+    {
+        const uint64_t linear = address & linear_mask;
+        return {static_cast<uint32_t>(address >> linear_bits), static_cast<uint32_t>(linear / page_size),
+                static_cast<uint32_t>(linear % page_size)};
+    }
+
+    uint64_t join(uint32_t segment, uint32_t page, uint32_t offset) const
+    {
+        return (static_cast<uint64_t>(segment) << linear_bits) | (static_cast<uint64_t>(page) * page_size + offset);
+    }
+
+    bool valid(uint64_t address) const { return (address & linear_mask) < segment_span; }
+
+private:
+    uint32_t page_size;
+    uint64_t segment_span;
+    uint32_t linear_bits;
+    uint64_t linear_mask;
+};
+
+// Función para llamar a f con la geometría especializada del tamaño de página pedido si es
+// uno de los tamaños comunes, o con una GenericGeometry si no. Devuelve true si se usó una
+// especialización. Así el bucle de f se compila una vez por geometría.
+template <uint32_t PageBits, typename F>
+bool withGeometry(uint32_t pageSize, F &&f)
+{
+    switch (pageSize)
+    {
+    case 50:
+        f(MemoryGeometry<50, PageBits>());
+        return true;
+    case 64:
+        f(MemoryGeometry<64, PageBits>());
+        return true;
+    case 100:
+        f(MemoryGeometry<100, PageBits>());
+        return true;
+    case 128:
+        f(MemoryGeometry<128, PageBits>());
+        return true;
+    case 256:
+        f(MemoryGeometry<256, PageBits>());
+        return true;
+    case 512:
+        f(MemoryGeometry<512, PageBits>());
+        return true;
+    case 1024:
+        f(MemoryGeometry<1024, PageBits>());
+        return true;
+    case 4096:
+        f(MemoryGeometry<4096, PageBits>());
+        return true;
+    default:
+        f(GenericGeometry(pageSize, PageBits));
+        return false;
+    }
+}
+
+#endif // MEMORY_GEOMETRY_H
@@ -3,6 +3,23 @@
 #include <fstream>
 #include <string>
 #include <vector>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <condition_variable>
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include "MemoryTrace.h"
+#include "SharedMemoryTable.h"
+#include "SwapFile.h"
 #include "nlohmann/json.hpp"
 
 using json = nlohmann::json;
@@ -10,7 +27,235 @@ using namespace std;
 
 string jsonRAMPath = "./projects_so/MemoryManager/RAM.json";
 string jsonSwapPath = "./projects_so/MemoryManager/Swap.json";
+string swapFilePath = "./projects_so/MemoryManager/Swap.dat";
 string filePath = "./projects_so/MemoryManager/ProgramaEjemplo.txt";
+static const int pageSize = 50; // Tamaño de página en caracteres
+static const int SWAP_CLUSTER_SIZE = 4; // Slots de Swap por cluster
+static const int TEXT_SEGMENT_ID = 1;   // Segmento de código: solo lectura y compartido
+static const int ADDRESS_PAGE_BITS = 16; // Páginas por segmento en una dirección virtual: 2^16
+using DefaultGeometry = MemoryGeometry<pageSize, ADDRESS_PAGE_BITS>;
+
+// Mutex que serializa el acceso al estado de memoria entre la CLI/GUI y el hilo del reclaimer.
+// Es recursivo porque algunas funciones públicas llaman a otras (memoryAllocation -> uploadToRam).
+static std::recursive_mutex memoryMutex;
+
+// Estado del reclaimer en segundo plano (estilo kswapd)
+struct ReclaimerThread {
+    std::thread worker;
+    std::mutex wakeMutex;
+    std::condition_variable wakeup;
+    bool stop = false;
+
+    ~ReclaimerThread()
+    {
+        if (worker.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> wakeLock(wakeMutex);
+                stop = true;
+            }
+            wakeup.notify_one();
+            worker.join();
+        }
+    }
+};
+
+// Segmento compartido con otros procesos (CLI, GUI). Se declara antes del reclaimer para
+// que se destruya después de detener su hilo.
+static SharedMemoryTable sharedTable;
+static int memoryLockDepth = 0; // Anidamiento de MemoryLock en el hilo que tiene memoryMutex
+
+// Escrituras de Swap de la operación en curso (slot, contenido). Se hacen recién al guardar
+// los JSON que apuntan a esos slots; si la operación no guarda (por ejemplo, el proceso no
+// entró en memoria) se descartan al soltar el MemoryLock más externo. Así el archivo de Swap
+// nunca tiene páginas de un estado que no se guardó.
+static std::vector<std::pair<int, std::string>> stagedSwapWrites;
+
+static void repairSharedTable();
+
+// Bloqueo para leer y modificar el estado de memoria. Toma memoryMutex y, si hay memoria
+// compartida, también el mutex entre procesos; este solo en el nivel más externo, porque
+// no es recursivo.
+struct MemoryLock {
+    bool sharedLocked = false;
+
+    MemoryLock()
+    {
+        memoryMutex.lock();
+        if (memoryLockDepth++ == 0 && sharedTable.isOpen())
+        {
+            sharedLocked = true;
+            if (!sharedTable.lock())
+            {
+                repairSharedTable();
+            }
+        }
+    }
+
+    ~MemoryLock()
+    {
+        if (--memoryLockDepth == 0)
+        {
+            stagedSwapWrites.clear();
+        }
+        if (sharedLocked)
+        {
+            sharedTable.unlock();
+        }
+        memoryMutex.unlock();
+    }
+};
+
+static ReclaimStats reclaimStats;
+static ZeroPoolStats zeroPoolStats;
+static WritebackStats writebackStats;
+static PFFConfig pffConfig;
+static MemoryTraceWriter memoryTrace;
+static bool lazyAllocation = false;  // Asignar frames en el primer acceso y no al cargar
+static long pagesMaterialized = 0;   // Páginas perezosas que ya recibieron sus frames
+static LoadControlConfig loadControlConfig;
+static ThrashingStats thrashingStats;
+static OomStats oomStats;
+static std::chrono::steady_clock::time_point thrashingStart;
+static std::vector<uint8_t> faultWindow; // 1 por cada referencia reciente que fue fallo (circular)
+static size_t faultWindowNext = 0;
+static size_t faultWindowFilled = 0;
+static int faultWindowFaults = 0;
+static long referencesSinceAction = 0;   // Referencias desde la última suspensión o reanudación
+static int reclaimHand = 0; // Manecilla del reloj sobre los frames de RAM
+
+// Histograma de latencias con cubetas logarítmicas al estilo HDR: cada potencia de 2 se
+// divide en LATENCY_SUB_BUCKETS cubetas, así que el error relativo es de 1/8. Se registra
+// con contadores atómicos, sin tomar ningún mutex.
+static const int LATENCY_SUB_BITS = 3;
+static const int LATENCY_SUB_BUCKETS = 1 << LATENCY_SUB_BITS;
+static const int LATENCY_BUCKETS = (64 - LATENCY_SUB_BITS + 1) * LATENCY_SUB_BUCKETS;
+
+static int latencyBucket(uint64_t ns)
+{
+    if (ns < static_cast<uint64_t>(LATENCY_SUB_BUCKETS))
+    {
+        return static_cast<int>(ns);
+    }
+    int msb = 63 - __builtin_clzll(ns);
+    int sub = static_cast<int>((ns >> (msb - LATENCY_SUB_BITS)) & (LATENCY_SUB_BUCKETS - 1));
+    return (msb - LATENCY_SUB_BITS + 1) * LATENCY_SUB_BUCKETS + sub;
+}
+
+// Límite inferior en nanosegundos de una cubeta
+static uint64_t latencyBucketValue(int bucket)
+{
+    if (bucket < LATENCY_SUB_BUCKETS)
+    {
+        return static_cast<uint64_t>(bucket);
+    }
+    int msb = bucket / LATENCY_SUB_BUCKETS + LATENCY_SUB_BITS - 1;
+    uint64_t sub = static_cast<uint64_t>(bucket % LATENCY_SUB_BUCKETS);
+    return (static_cast<uint64_t>(LATENCY_SUB_BUCKETS) + sub) << (msb - LATENCY_SUB_BITS);
+}
+
+struct LatencyHistogram {
+    std::atomic<uint64_t> buckets[LATENCY_BUCKETS] = {};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> max_ns{0};
+
+    void record(uint64_t ns, uint64_t movedBytes)
+    {
+        buckets[latencyBucket(ns)].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(movedBytes, std::memory_order_relaxed);
+        total_ns.fetch_add(ns, std::memory_order_relaxed);
+        uint64_t previous = max_ns.load(std::memory_order_relaxed);
+        while (ns > previous && !max_ns.compare_exchange_weak(previous, ns, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    // Valor de la cubeta donde cae el percentil pedido (0..1)
+    uint64_t percentile(double fraction) const
+    {
+        uint64_t total = count.load(std::memory_order_relaxed);
+        if (total == 0)
+        {
+            return 0;
+        }
+        uint64_t target = static_cast<uint64_t>(std::ceil(fraction * total));
+        uint64_t seen = 0;
+        for (int i = 0; i < LATENCY_BUCKETS; ++i)
+        {
+            seen += buckets[i].load(std::memory_order_relaxed);
+            if (seen >= target)
+            {
+                return latencyBucketValue(i);
+            }
+        }
+        return max_ns.load(std::memory_order_relaxed);
+    }
+
+    void reset()
+    {
+        for (auto &bucket : buckets)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        count.store(0, std::memory_order_relaxed);
+        bytes.store(0, std::memory_order_relaxed);
+        total_ns.store(0, std::memory_order_relaxed);
+        max_ns.store(0, std::memory_order_relaxed);
+    }
+};
+
+static const int OPERATION_COUNT = static_cast<int>(MemoryOperation::Count);
+static const char *operationNames[OPERATION_COUNT] = {
+    "allocate", "allocate-batch", "free", "swap", "read", "write", "getPage", "getPages", "updateTable"};
+static LatencyHistogram operationLatency[OPERATION_COUNT];
+static std::atomic<uint64_t> pageFaults{0};
+static std::atomic<uint64_t> evictions{0};
+static std::atomic<uint64_t> bytesSwappedIn{0};
+static std::atomic<uint64_t> bytesWrittenBack{0};
+static std::atomic<uint64_t> readaheadPages{0}; // Páginas leídas por adelantado al traer otra
+static std::atomic<uint64_t> readaheadHits{0};  // Fallos resueltos con una página leída por adelantado
+
+// Dispositivo de Swap: un archivo de slots que cubre un rango contiguo de los frames de
+// Swap.json. Los de mayor prioridad se llenan primero y los de igual prioridad se turnan.
+struct SwapDevice {
+    std::string path;
+    int priority = 0;
+    int first_slot = 0;
+    int slots = 0;
+    SwapFile file;
+    LatencyHistogram reads;
+    LatencyHistogram writes;
+};
+static std::vector<std::unique_ptr<SwapDevice>> swapDevices;
+static std::map<int, size_t> stripeCursor; // Prioridad -> próximo dispositivo de su turno
+static bool swapDirectIO = false;
+
+// Páginas leídas por adelantado de Swap (slot -> contenido), solo la última ventana. Un slot
+// sale de acá al traerse a RAM o al escribirse. Con memoria compartida la ventana vale
+// mientras ningún otro proceso guardó cambios: readaheadSequence es la secuencia del seqlock
+// después de la última escritura propia.
+static std::map<int, std::string> swapReadahead;
+static uint32_t readaheadSequence = 0;
+
+// Se declara después de los dispositivos de Swap, que usa al desalojar, para que se destruya antes
+static ReclaimerThread reclaimer;
+
+// Mide una operación pública desde su creación hasta el final del bloque
+struct OperationTimer {
+    MemoryOperation operation;
+    uint64_t bytes = 0; // Bytes movidos por la operación, los completa la función medida
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    explicit OperationTimer(MemoryOperation operation) : operation(operation) {}
+    ~OperationTimer()
+    {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        operationLatency[static_cast<int>(operation)].record(static_cast<uint64_t>(elapsed.count()), bytes);
+    }
+};
 
 MemoryCalculator::MemoryCalculator(const std::vector<Frame>& frames) : frames(frames) {}
 
@@ -34,7 +279,118 @@ int MemoryCalculator::calculateMemoryUsedByProcess(int process_id) {
     return used_frames * FRAME_SIZE;
 }
 
+// Manejador SAX que arma la tabla de frames mientras se lee el archivo, sin construir el
+// documento JSON completo. Solo se copian los campos de "frames" que usa Frame; el resto
+// del documento (por ejemplo las tablas "SO") se recorre sin guardar nada.
+struct FrameSaxHandler
+{
+    std::vector<Frame> &frames;
+    int depth = 0;            // Profundidad de objetos y arreglos abiertos
+    bool inFrames = false;    // Dentro del arreglo "frames" de primer nivel
+    std::string currentKey;   // Última clave leída
+    std::string errorMessage;
+
+    explicit FrameSaxHandler(std::vector<Frame> &frames) : frames(frames) {}
+
+    // Los frames son objetos a profundidad 3: documento > "frames" > frame
+    bool inFrame() const { return inFrames && depth == 3; }
+
+    bool setInt(long long value)
+    {
+        if (inFrame())
+        {
+            Frame &frame = frames.back();
+            if (currentKey == "frame_number")
+                frame.frame_number = static_cast<int>(value);
+            else if (currentKey == "page_number")
+                frame.page_number = static_cast<int>(value);
+            else if (currentKey == "process_id")
+                frame.process_id = static_cast<int>(value);
+            else if (currentKey == "segment_id")
+                frame.segment_id = static_cast<int>(value);
+        }
+        return true;
+    }
+
+    bool null() { return true; }
+    bool boolean(bool val)
+    {
+        if (inFrame() && currentKey == "is_free")
+            frames.back().is_free = val;
+        return true;
+    }
+    bool number_integer(json::number_integer_t val) { return setInt(val); }
+    bool number_unsigned(json::number_unsigned_t val) { return setInt(static_cast<long long>(val)); }
+    bool number_float(json::number_float_t, const json::string_t &) { return true; }
+    bool string(json::string_t &val)
+    {
+        if (inFrame() && currentKey == "content")
+            frames.back().content = std::move(val);
+        return true;
+    }
+    bool binary(json::binary_t &) { return true; }
+    bool start_object(std::size_t)
+    {
+        depth++;
+        if (inFrame())
+            frames.push_back({"", 0, true, 0, 0, 0});
+        return true;
+    }
+    bool end_object()
+    {
+        depth--;
+        return true;
+    }
+    bool start_array(std::size_t)
+    {
+        depth++;
+        if (depth == 2 && currentKey == "frames")
+            inFrames = true;
+        return true;
+    }
+    bool end_array()
+    {
+        if (depth == 2)
+            inFrames = false;
+        depth--;
+        return true;
+    }
+    bool key(json::string_t &val)
+    {
+        currentKey = std::move(val);
+        return true;
+    }
+    bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &ex)
+    {
+        errorMessage = ex.what();
+        return false;
+    }
+};
+
 std::vector<Frame> loadFramesFromJson(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("No se pudo abrir el archivo JSON");
+    }
+
+    // Reservar según el tamaño del archivo: un frame formateado ocupa al menos ~150 bytes
+    std::vector<Frame> frames;
+    frames.reserve(static_cast<size_t>(file.tellg()) / 150 + 1);
+    file.seekg(0);
+
+    FrameSaxHandler handler(frames);
+    if (!json::sax_parse(file, &handler))
+    {
+        throw std::runtime_error("JSON inválido en " + filename + ": " + handler.errorMessage);
+    }
+
+    return frames;
+}
+
+// Versión anterior que construye el documento completo; se conserva para comparar tiempos
+static std::vector<Frame> loadFramesFromJsonDom(const std::string &filename)
 {
     std::ifstream file(filename);
     if (!file.is_open())
@@ -59,479 +415,3394 @@ std::vector<Frame> loadFramesFromJson(const std::string &filename)
     return frames;
 }
 
-// Método para calcular la memoria libre de todo el sistema
-int freeMem()
+// Función para medir la carga de una imagen sintética de frameCount frames con el lector
+// SAX y con el DOM. La imagen se escribe en imagePath y se borra al terminar.
+FrameLoadBenchmark benchmarkFrameLoad(int frameCount, const std::string &imagePath)
 {
-    vector<Frame> frames = loadFramesFromJson(jsonRAMPath);
-    MemoryCalculator memoryCalculator(frames);
-    int available_memory = memoryCalculator.calculateAvailableMemory();
-    return available_memory;
+    FrameLoadBenchmark result;
+    result.frames = frameCount;
+    {
+        std::ofstream image(imagePath);
+        if (!image.is_open())
+        {
+            std::cerr << "No se pudo crear la imagen de prueba: " << imagePath << std::endl;
+            return result;
+        }
+        image << "{\n    \"SO\": [],\n    \"frames\": [\n";
+        for (int i = 0; i < frameCount; ++i)
+        {
+            image << "        {\n"
+                  << "            \"content\": \"" << (i % 2 ? "Segmento 1 Página 1\\nSegmento 1 Página 2" : "") << "\",\n"
+                  << "            \"frame_number\": " << i << ",\n"
+                  << "            \"is_free\": " << (i % 2 ? "false" : "true") << ",\n"
+                  << "            \"page_number\": " << i % 4 << ",\n"
+                  << "            \"process_id\": " << i % 16 << ",\n"
+                  << "            \"segment_id\": " << i % 3 << "\n"
+                  << "        }" << (i + 1 < frameCount ? "," : "") << "\n";
+        }
+        image << "    ]\n}\n";
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    size_t loaded = loadFramesFromJsonDom(imagePath).size();
+    auto middle = std::chrono::steady_clock::now();
+    loaded += loadFramesFromJson(imagePath).size();
+    auto end = std::chrono::steady_clock::now();
+
+    result.dom_seconds = std::chrono::duration<double>(middle - start).count();
+    result.sax_seconds = std::chrono::duration<double>(end - middle).count();
+    result.ok = loaded == 2 * static_cast<size_t>(frameCount);
+    std::remove(imagePath.c_str());
+    return result;
 }
 
-// Función para dividir una cadena en páginas de un tamaño específico
-vector<string> pagination(const string &text, int size)
+// Función para medir la traducción de direcciones con la geometría especializada para
+// pageSize y con la genérica, que divide por una variable
+AddressTranslationBenchmark benchmarkAddressTranslation(int count, int pageSize)
 {
-    vector<string> pages;
-    for (size_t i = 0; i < text.size(); i += size)
+    AddressTranslationBenchmark result;
+    result.addresses = count;
+    result.page_size = pageSize;
+    if (count <= 0 || pageSize <= 0)
     {
-        pages.push_back(text.substr(i, size));
+        return result;
     }
-    return pages;
-}
 
-// Función usada para contar el numero de lineas de un archivo
-int countLines(const string &filePath)
-{
-    ifstream archivo(filePath);
-    if (!archivo.is_open())
+    GenericGeometry generic(static_cast<uint32_t>(pageSize), ADDRESS_PAGE_BITS);
+    std::vector<uint64_t> addresses(static_cast<size_t>(count));
+    uint64_t state = 88172645463325252ULL;
+    for (auto &address : addresses)
     {
-        cerr << "No se pudo abrir el archivo: " << filePath << endl;
-        return -1; // Devuelve -1 si no se puede abrir el archivo
+        // xorshift64: segmentos 1 a 3, páginas y desplazamientos al azar
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        uint32_t page = static_cast<uint32_t>(state >> 40) & ((1u << ADDRESS_PAGE_BITS) - 1);
+        address = generic.join(static_cast<uint32_t>(state % 3) + 1, page, static_cast<uint32_t>(state >> 8) % pageSize);
     }
 
-    int line_counter = 0;
-    string linea;
+    uint64_t specializedSum = 0;
+    auto start = std::chrono::steady_clock::now();
+    result.specialized = withGeometry<ADDRESS_PAGE_BITS>(static_cast<uint32_t>(pageSize), [&](const auto &geometry)
+                                                         {
+                                                             for (uint64_t address : addresses)
+                                                             {
+                                                                 VirtualAddress parts = geometry.split(address);
+                                                                 specializedSum += parts.segment * 31 + parts.page * 7 + parts.offset;
+                                                             }
+                                                         });
+    auto middle = std::chrono::steady_clock::now();
+    uint64_t genericSum = 0;
+    for (uint64_t address : addresses)
+    {
+        VirtualAddress parts = generic.split(address);
+        genericSum += parts.segment * 31 + parts.page * 7 + parts.offset;
+    }
+    auto end = std::chrono::steady_clock::now();
 
-    while (getline(archivo, linea))
+    result.specialized_seconds = std::chrono::duration<double>(middle - start).count();
+    result.generic_seconds = std::chrono::duration<double>(end - middle).count();
+    result.ok = specializedSum == genericSum;
+    return result;
+}
+
+// Función para escribir un JSON formateado con 4 espacios en un archivo temporal y
+// reemplazar el original con un rename, así un error a mitad de camino no lo deja vacío
+static bool writeJsonFile(const std::string &path, const json &document)
+{
+    std::string temporal = path + ".tmp";
+    std::ofstream salida(temporal);
+    if (!salida.is_open())
     {
-        line_counter++;
+        return false;
+    }
+    salida << document.dump(4);
+    salida.close();
+    std::error_code error;
+    if (salida)
+    {
+        std::filesystem::rename(temporal, path, error);
+        if (!error)
+        {
+            return true;
+        }
     }
+    std::filesystem::remove(temporal, error);
+    return false;
+}
 
-    archivo.close();
-    return line_counter;
+static bool saveSwapJson(const json &jsonSwap)
+{
+    if (!writeJsonFile(jsonSwapPath, jsonSwap))
+    {
+        std::cerr << "No se pudo guardar el archivo secundario JSON: " << jsonSwapPath << std::endl;
+        return false;
+    }
+    return true;
 }
 
-// Función usada para liberar la memoria de un proceso
-void releaseMemory(int process_id)
+// Función para obtener la lista de dispositivos de Swap del JSON secundario. Sin lista hay
+// un solo dispositivo, Swap.dat, con todos los slots.
+static json swapDeviceList(const json &jsonSwap)
 {
-    std::ifstream ramJsonFile(jsonRAMPath);
-    std::ifstream swapJsonFile(jsonSwapPath);
+    if (jsonSwap.contains("devices") && !jsonSwap["devices"].empty())
+    {
+        return jsonSwap["devices"];
+    }
+    return json::array({{{"path", swapFilePath}, {"priority", 0}, {"slots", jsonSwap["frames"].size()}}});
+}
 
-    json jsonRAM;
-    json jsonSwap;
+static SwapDevice *deviceForSlot(int slot)
+{
+    for (auto &device : swapDevices)
+    {
+        if (slot >= device->first_slot && slot < device->first_slot + device->slots)
+        {
+            return device.get();
+        }
+    }
+    return nullptr;
+}
 
-    // Manejo del JSON principal
-    if (ramJsonFile.is_open())
+// Función para abrir los dispositivos de Swap del JSON secundario. Solo se reabren si cambió
+// su ruta o su rango de slots. Si el JSON todavía trae el contenido de las páginas (formato
+// anterior), se pasa a los slots y migrated queda en true.
+static bool prepareSwapFile(json &jsonSwap, bool &migrated)
+{
+    json devices = swapDeviceList(jsonSwap);
+    int first_slot = 0;
+    for (const auto &device : devices)
     {
-        ramJsonFile >> jsonRAM;
-        ramJsonFile.close();
+        first_slot += device["slots"].get<int>();
     }
-    else
+    if (first_slot != static_cast<int>(jsonSwap["frames"].size()))
     {
-        std::cerr << "No se pudo abrir el archivo principal JSON: " << jsonRAMPath << std::endl;
-        return;
+        std::cerr << "Los dispositivos de Swap no suman los " << jsonSwap["frames"].size() << " frames de Swap" << std::endl;
+        return false;
     }
 
-    // Manejo del JSON secundario
-    if (swapJsonFile.is_open())
+    bool same = swapDevices.size() == devices.size();
+    first_slot = 0;
+    for (size_t i = 0; same && i < devices.size(); ++i)
     {
-        swapJsonFile >> jsonSwap;
-        swapJsonFile.close();
+        same = swapDevices[i]->file.isOpen() && swapDevices[i]->path == devices[i]["path"] &&
+               swapDevices[i]->first_slot == first_slot && swapDevices[i]->slots == devices[i]["slots"];
+        first_slot += devices[i]["slots"].get<int>();
     }
-    else
+    if (!same)
     {
-        std::cerr << "No se pudo abrir el archivo secundario JSON: " << jsonSwapPath << std::endl;
-        return;
+        swapDevices.clear();
+        stripeCursor.clear();
+        swapReadahead.clear();
+        first_slot = 0;
+        for (const auto &entry : devices)
+        {
+            auto device = std::make_unique<SwapDevice>();
+            device->path = entry["path"];
+            device->first_slot = first_slot;
+            device->slots = entry["slots"];
+            bool created = false;
+            if (!device->file.open(device->path, static_cast<uint32_t>(device->slots), swapDirectIO, created))
+            {
+                swapDevices.clear();
+                return false;
+            }
+            first_slot += device->slots;
+            swapDevices.push_back(std::move(device));
+        }
+    }
+    // La prioridad se puede cambiar sin reabrir
+    for (size_t i = 0; i < devices.size(); ++i)
+    {
+        swapDevices[i]->priority = devices[i].value("priority", 0);
     }
 
-    // Liberar frames en el JSON principal
-    for (auto &frame : jsonRAM["frames"])
+    for (auto &frame : jsonSwap["frames"])
     {
-        if (frame["process_id"] == process_id && !frame["is_free"])
+        auto content = frame.find("content");
+        if (content == frame.end())
         {
-            frame["is_free"] = true;  // Indicar página libre
-            frame["segment_id"] = 0;  // Reiniciar segment_id
-            frame["page_number"] = 0; // Reiniciar page_number
-            frame["content"] = "";    // Limpiar contenido
+            continue;
         }
+        int slot = frame["frame_number"];
+        swapReadahead.erase(slot);
+        SwapDevice *device = deviceForSlot(slot);
+        if (!content->get_ref<const std::string &>().empty() &&
+            (device == nullptr ||
+             !device->file.write(static_cast<uint32_t>(slot - device->first_slot), content->get_ref<const std::string &>())))
+        {
+            return false;
+        }
+        frame.erase(content);
+        migrated = true;
     }
+    return true;
+}
 
-    // Borrar tablas de direcciones asociadas al proceso
-    jsonRAM["SO"].erase(
-        std::remove_if(
-            jsonRAM["SO"].begin(),
-            jsonRAM["SO"].end(),
-            [process_id](const json &item)
-            { return item["process_id"] == process_id; }),
-        jsonRAM["SO"].end());
+static uint64_t elapsedNs(std::chrono::steady_clock::time_point start)
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
 
-    // Liberar frames en el JSON secundario
-    for (auto &frame : jsonSwap["frames"])
+// Funciones para leer y escribir el contenido de una página en su slot de Swap, en el
+// dispositivo que tiene ese slot. La lectura ve las escrituras pendientes de la operación.
+static const std::string *stagedSwapContent(int slot)
+{
+    for (auto it = stagedSwapWrites.rbegin(); it != stagedSwapWrites.rend(); ++it)
     {
-        if (frame["process_id"] == process_id && !frame["is_free"])
+        if (it->first == slot)
         {
-            frame["is_free"] = true;  // Actualizar is_free
-            frame["segment_id"] = 0;  // Reiniciar segment_id
-            frame["page_number"] = 0; // Reiniciar page_number
-            frame["content"] = "";    // Limpiar contenido
+            return &it->second;
         }
     }
+    return nullptr;
+}
 
-    // Guardar los JSON actualizados en sus archivos correspondientes
-    std::ofstream archivoPrincipalJsonSalida(jsonRAMPath);
-    if (archivoPrincipalJsonSalida.is_open())
+static bool readSwapSlot(int slot, std::string &content)
+{
+    if (const std::string *staged = stagedSwapContent(slot))
     {
-        archivoPrincipalJsonSalida << jsonRAM.dump(4);
-        archivoPrincipalJsonSalida.close();
+        content = *staged;
+        return true;
     }
-    else
+
+    SwapDevice *device = deviceForSlot(slot);
+    auto start = std::chrono::steady_clock::now();
+    if (device == nullptr || !device->file.read(static_cast<uint32_t>(slot - device->first_slot), content))
     {
-        std::cerr << "No se pudo guardar el archivo principal JSON: " << jsonRAMPath << std::endl;
-        return;
+        return false;
     }
+    device->reads.record(elapsedNs(start), content.size());
+    return true;
+}
 
-    std::ofstream archivoSecundarioJsonSalida(jsonSwapPath);
-    if (archivoSecundarioJsonSalida.is_open())
+static bool writeSwapSlot(int slot, const std::string &content)
+{
+    swapReadahead.erase(slot);
+    SwapDevice *device = deviceForSlot(slot);
+    auto start = std::chrono::steady_clock::now();
+    if (device == nullptr || !device->file.write(static_cast<uint32_t>(slot - device->first_slot), content))
     {
-        archivoSecundarioJsonSalida << jsonSwap.dump(4);
-        archivoSecundarioJsonSalida.close();
+        return false;
     }
-    else
+    device->writes.record(elapsedNs(start), content.size());
+    return true;
+}
+
+// Función para dejar pendiente la escritura de un slot hasta que se guarde la operación
+static bool stageSwapWrite(int slot, const std::string &content)
+{
+    if (content.size() > SWAP_SLOT_CAPACITY)
     {
-        std::cerr << "No se pudo guardar el archivo secundario JSON: " << jsonSwapPath << std::endl;
-        return;
+        std::cerr << "El contenido no cabe en un slot de Swap: " << content.size() << " bytes" << std::endl;
+        return false;
     }
+    swapReadahead.erase(slot);
+    stagedSwapWrites.emplace_back(slot, content);
+    return true;
+}
 
-    std::cout << "Memoria liberada en JSON principal y secundario para process_id: " << process_id << std::endl;
+// Función para leer count slots contiguos con una sola lectura por dispositivo. contents
+// queda con los slots que se pudieron leer, desde first; devuelve los bytes leídos.
+static uint64_t readSwapRange(int first, int count, std::vector<std::string> &contents)
+{
+    uint64_t total = 0;
+    int slot = first;
+    while (slot < first + count)
+    {
+        SwapDevice *device = deviceForSlot(slot);
+        if (device == nullptr)
+        {
+            break;
+        }
+        int end = std::min(first + count, device->first_slot + device->slots);
+        size_t before = contents.size();
+        auto start = std::chrono::steady_clock::now();
+        if (!device->file.readRange(static_cast<uint32_t>(slot - device->first_slot), static_cast<uint32_t>(end - slot), contents))
+        {
+            break;
+        }
+        uint64_t bytes = 0;
+        for (size_t i = before; i < contents.size(); ++i)
+        {
+            bytes += contents[i].size();
+        }
+        device->reads.record(elapsedNs(start), bytes);
+        total += bytes;
+        slot = end;
+    }
+    return total;
 }
 
-void uploadToRam(const std::vector<std::vector<std::string>> &segments, int process_id)
+// Función para hacer las escrituras de Swap pendientes, en orden
+static bool flushSwapWrites()
+{
+    bool ok = true;
+    for (const auto &write : stagedSwapWrites)
+    {
+        ok = writeSwapSlot(write.first, write.second) && ok;
+    }
+    stagedSwapWrites.clear();
+    return ok;
+}
+
+// Función para leer los archivos JSON de RAM y Swap
+static bool loadJsonFiles(json &jsonRAM, json &jsonSwap)
 {
-    // Leer ambos archivos JSON existentes
     std::ifstream ramJsonFile(jsonRAMPath);
+    if (!ramJsonFile.is_open())
+    {
+        std::cerr << "No se pudo abrir el archivo principal JSON: " << jsonRAMPath << std::endl;
+        return false;
+    }
+    ramJsonFile >> jsonRAM;
+    ramJsonFile.close();
+
     std::ifstream swapJsonFile(jsonSwapPath);
+    if (!swapJsonFile.is_open())
+    {
+        std::cerr << "No se pudo abrir el archivo secundario JSON: " << jsonSwapPath << std::endl;
+        return false;
+    }
+    swapJsonFile >> jsonSwap;
+    swapJsonFile.close();
 
-    json jsonRAM;
-    json jsonSwap;
+    // El formato anterior se guarda ya convertido, así el contenido viejo del JSON no vuelve
+    // a pisar los slots en la próxima lectura
+    bool migrated = false;
+    return prepareSwapFile(jsonSwap, migrated) && (!migrated || saveSwapJson(jsonSwap));
+}
 
-    // Manejo del JSON principal
-    if (ramJsonFile.is_open())
+// Función para guardar los JSON de RAM y Swap en sus archivos correspondientes, después
+// de las páginas pendientes en Swap. Swap.json solo se reescribe si swapChanged.
+static bool saveJsonFiles(const json &jsonRAM, const json &jsonSwap, bool swapChanged)
+{
+    if (!flushSwapWrites())
     {
-        ramJsonFile >> jsonRAM;
-        ramJsonFile.close();
+        std::cerr << "No se pudieron escribir las páginas en Swap; no se guardaron los JSON" << std::endl;
+        return false;
     }
+    if (!writeJsonFile(jsonRAMPath, jsonRAM))
+    {
+        std::cerr << "No se pudo guardar el archivo principal JSON: " << jsonRAMPath << std::endl;
+        return false;
+    }
+    return !swapChanged || saveSwapJson(jsonSwap);
+}
 
-    // Manejo del JSON secundario
-    if (swapJsonFile.is_open())
+static Frame toFrame(const SharedFrame &shared)
+{
+    return {std::string(shared.content, shared.content_length), shared.frame_number, shared.is_free != 0,
+            shared.page_number, shared.process_id, shared.segment_id};
+}
+
+// Función para copiar los frames de un JSON a la memoria compartida
+static void storeSharedFrames(const json &frames, SharedFrame *shared, uint32_t count)
+{
+    for (uint32_t i = 0; i < count && i < frames.size(); ++i)
     {
-        swapJsonFile >> jsonSwap;
-        swapJsonFile.close();
+        const auto &frame = frames[i];
+        // Los frames de Swap no llevan contenido: está en el archivo de Swap
+        static const std::string noContent;
+        const std::string &content = frame.contains("content") ? frame["content"].get_ref<const std::string &>() : noContent;
+        shared[i].frame_number = frame["frame_number"];
+        shared[i].page_number = frame["page_number"];
+        shared[i].process_id = frame["process_id"];
+        shared[i].segment_id = frame["segment_id"];
+        shared[i].is_free = frame["is_free"].get<bool>() ? 1 : 0;
+        shared[i].content_length = static_cast<uint8_t>(std::min<size_t>(content.size(), SHARED_CONTENT_SIZE));
+        std::memcpy(shared[i].content, content.data(), shared[i].content_length);
     }
+}
 
-    // **Verificar si el proceso ya existe en JSON principal**
-    auto &soEntries = jsonRAM["SO"];
-    for (auto it = soEntries.begin(); it != soEntries.end(); ++it)
+static json loadSharedFrames(const SharedFrame *shared, uint32_t count, bool withContent)
+{
+    json frames = json::array();
+    for (uint32_t i = 0; i < count; ++i)
     {
-        if ((*it)["process_id"] == process_id)
+        Frame frame = toFrame(shared[i]);
+        frames.push_back({{"frame_number", frame.frame_number},
+                          {"is_free", frame.is_free},
+                          {"page_number", frame.page_number},
+                          {"process_id", frame.process_id},
+                          {"segment_id", frame.segment_id}});
+        if (withContent)
         {
-            // Liberar memoria del proceso existente
-            releaseMemory(process_id);
-
-            // **Actualizar jsonRAM tras liberar memoria**
-            // Leer de nuevo el archivo JSON principal para sincronizar los cambios
-            std::ifstream updatedRamJsonFile(jsonRAMPath);
-            if (updatedRamJsonFile.is_open())
-            {
-                updatedRamJsonFile >> jsonRAM;
-                updatedRamJsonFile.close();
-            }
-            else
-            {
-                std::cerr << "Error al leer JSON principal tras liberar memoria" << std::endl;
-                return;
-            }
-
-            // **Actualizar jsonSwap tras liberar memoria**
-            // Leer de nuevo el archivo JSON secundario para sincronizar los cambios
-            std::ifstream updatedSwapJsonFile(jsonSwapPath);
-            if (updatedSwapJsonFile.is_open())
-            {
-                updatedSwapJsonFile >> jsonSwap;
-                updatedSwapJsonFile.close();
-            }
-            else
-            {
-                std::cerr << "Error al leer JSON secundario tras liberar memoria" << std::endl;
-                return;
-            }
-
-            break;
+            frames.back()["content"] = frame.content;
         }
     }
+    return frames;
+}
 
-    int ramFrame_id = 0;
-    int swapFrame_id = 0;
-
-    // Crear un objeto para el proceso en el JSON principal
-    json processEntry;
-    processEntry["process_id"] = process_id;  // El ID del proceso
-    processEntry["segments"] = json::array(); // Inicializar el array de segmentos
-
-    // Iterar sobre los segmentos y paginas para organizarlas en los JSON
-    for (size_t i = 0; i < segments.size(); ++i)
+// Todo lo que no es "frames" (tablas SO y demás) se guarda serializado en MessagePack
+static json withoutFrames(const json &document)
+{
+    json rest = json::object();
+    for (auto it = document.begin(); it != document.end(); ++it)
     {
-        const auto &pages = segments[i];
+        if (it.key() != "frames")
+        {
+            rest[it.key()] = it.value();
+        }
+    }
+    return rest;
+}
 
-        // Crear las tablas de paginación para este proceso
-        json segmentEntry;
-        segmentEntry["segment_id"] = static_cast<int>(i + 1);
-        segmentEntry["pages"] = json::array();
+// Función para armar los JSON a partir de los frames y las tablas serializadas del segmento
+static bool decodeSharedJson(const SharedFrame *ram, uint32_t ramCount, const SharedFrame *swap, uint32_t swapCount,
+                             const uint8_t *tables, uint32_t tablesSize, json &jsonRAM, json &jsonSwap)
+{
+    json rest = json::from_msgpack(tables, tables + tablesSize);
+    jsonRAM = rest["ram"];
+    jsonSwap = rest["swap"];
+    jsonRAM["frames"] = loadSharedFrames(ram, ramCount, true);
+    jsonSwap["frames"] = loadSharedFrames(swap, swapCount, false);
+    bool migrated = false;
+    return prepareSwapFile(jsonSwap, migrated);
+}
 
-        // Guardar las paginas restantes en el JSON secundario
-        for (size_t j = 0; j < pages.size(); ++j)
-        {
-            // Buscar el próximo campo "libre" en el JSON secundario
-            while (swapFrame_id < jsonSwap["frames"].size() && jsonSwap["frames"][swapFrame_id]["is_free"] == false)
-            {
-                swapFrame_id++; // Saltar campos ocupados
-            }
+// Función para leer el estado desde la memoria compartida (con el mutex de escritura tomado)
+static bool loadSharedJson(json &jsonRAM, json &jsonSwap)
+{
+    SharedHeader *header = sharedTable.getHeader();
+    return decodeSharedJson(sharedTable.ramFrames(), header->ram_frames, sharedTable.swapFrames(), header->swap_frames,
+                            sharedTable.tables(), header->tables_size, jsonRAM, jsonSwap);
+}
 
-            if (swapFrame_id >= jsonSwap["frames"].size())
-            {
-                std::cerr << "Memoria Swap Insuficiente" << std::endl;
-                return;
-            }
+// Función para publicar el estado en la memoria compartida (con el mutex de escritura tomado)
+static bool saveSharedJson(const json &jsonRAM, const json &jsonSwap, bool swapChanged)
+{
+    SharedHeader *header = sharedTable.getHeader();
+    std::vector<uint8_t> tables = json::to_msgpack(json{{"ram", withoutFrames(jsonRAM)}, {"swap", withoutFrames(jsonSwap)}});
+    if (tables.size() > header->tables_capacity)
+    {
+        std::cerr << "Las tablas de páginas no caben en la memoria compartida (" << tables.size() << " de "
+                  << header->tables_capacity << " bytes); no se guardaron los cambios" << std::endl;
+        return false;
+    }
+    // Si la operación escribe páginas en Swap también se guardan los JSON (primero Swap, después
+    // los JSON): si todos los procesos terminan sin desconectarse, el próximo arranca de JSON
+    // que están de acuerdo con los slots
+    if (!stagedSwapWrites.empty() && !saveJsonFiles(jsonRAM, jsonSwap, true))
+    {
+        return false;
+    }
+
+    // Las escrituras propias no invalidan las páginas leídas por adelantado
+    bool readaheadCurrent = header->sequence.load(std::memory_order_relaxed) == readaheadSequence;
+    sharedTable.beginWrite();
+    storeSharedFrames(jsonRAM["frames"], sharedTable.ramFrames(), header->ram_frames);
+    if (swapChanged)
+    {
+        storeSharedFrames(jsonSwap["frames"], sharedTable.swapFrames(), header->swap_frames);
+    }
+    std::memcpy(sharedTable.tables(), tables.data(), tables.size());
+    header->tables_size = static_cast<uint32_t>(tables.size());
+    sharedTable.endWrite();
+    if (readaheadCurrent)
+    {
+        readaheadSequence = header->sequence.load(std::memory_order_relaxed);
+    }
+    return true;
+}
 
-            // Actualizar la entrada correspondiente en el JSON secundario
-            jsonSwap["frames"][swapFrame_id]["segment_id"] = static_cast<int>(i + 1);
-            jsonSwap["frames"][swapFrame_id]["page_number"] = static_cast<int>(j + 1);
-            jsonSwap["frames"][swapFrame_id]["content"] = pages[j];
-            jsonSwap["frames"][swapFrame_id]["process_id"] = process_id;
-            jsonSwap["frames"][swapFrame_id]["is_free"] = false; // Marcar como ocupado
+// Función para rehacer la memoria compartida desde RAM.json y Swap.json cuando un proceso
+// terminó mientras la modificaba y el segmento puede estar a medias. Se pierde lo hecho
+// desde la última operación que escribió en Swap, que es cuando se guardan los JSON.
+static void repairSharedTable()
+{
+    std::cerr << "Un proceso terminó mientras modificaba la memoria compartida; se recarga desde los JSON" << std::endl;
+    json jsonRAM;
+    json jsonSwap;
+    if (!loadJsonFiles(jsonRAM, jsonSwap) || !saveSharedJson(jsonRAM, jsonSwap, true))
+    {
+        std::cerr << "No se pudo recargar la memoria compartida" << std::endl;
+    }
+}
 
-            // Añadir la página en la tabla de paginación del segmento
-            json pageEntry;
-            pageEntry["page_number"] = static_cast<int>(j + 1);
-            pageEntry["frame_swap"] = swapFrame_id;
-            pageEntry["frame_ram"] = -1;
-            pageEntry["presence_bit"] = 0;
-            segmentEntry["pages"].push_back(pageEntry);
+// Función para copiar frames de la memoria compartida sin tomar el mutex de escritura:
+// se reintenta si un escritor los modificó durante la copia (seqlock)
+static std::vector<SharedFrame> readSharedFrames(bool swap, uint32_t first, uint32_t count)
+{
+    std::vector<SharedFrame> copy;
+    for (;;)
+    {
+        uint32_t sequence;
+        if (!sharedTable.beginRead(sequence))
+        {
+            // Escritura que no termina: tomar el mutex espera al escritor o, si terminó sin
+            // soltarlo, recupera el segmento
+            MemoryLock lock;
+            continue;
         }
-
-        // Guardar la primera subparte en el JSON principal
-        if (!pages.empty())
+        SharedHeader *header = sharedTable.getHeader();
+        uint32_t total = swap ? header->swap_frames : header->ram_frames;
+        const SharedFrame *frames = swap ? sharedTable.swapFrames() : sharedTable.ramFrames();
+        uint32_t end = std::min(total, first + count);
+        copy.assign(frames + std::min(first, end), frames + end);
+        if (sharedTable.validateRead(sequence))
         {
-            // Buscar el próximo campo "libre" en el JSON principal
-            while (ramFrame_id < jsonRAM["frames"].size() && jsonRAM["frames"][ramFrame_id]["is_free"] == false)
-            {
-                ramFrame_id++; // Saltar campos ocupados
-            }
+            return copy;
+        }
+    }
+}
 
-            if (ramFrame_id >= jsonRAM["frames"].size())
-            {
-                std::cerr << "Memoria RAM Insuficiente" << std::endl;
-                return;
-            }
+// Función para leer el estado de memoria: de la memoria compartida si está conectada,
+// si no de los archivos JSON
+static bool loadMemoryJson(json &jsonRAM, json &jsonSwap)
+{
+    if (sharedTable.isOpen())
+    {
+        return loadSharedJson(jsonRAM, jsonSwap);
+    }
+    return loadJsonFiles(jsonRAM, jsonSwap);
+}
 
-            // Actualizar la entrada correspondiente en el JSON principal
-            jsonRAM["frames"][ramFrame_id]["segment_id"] = static_cast<int>(i + 1);
-            jsonRAM["frames"][ramFrame_id]["page_number"] = 1;
-            jsonRAM["frames"][ramFrame_id]["content"] = pages[0];
-            jsonRAM["frames"][ramFrame_id]["process_id"] = process_id;
-            jsonRAM["frames"][ramFrame_id]["is_free"] = false;
+// Función para leer el estado de memoria en las consultas que no lo modifican. Con memoria
+// compartida copia el segmento sin tomar el mutex de escritura, reintentando si hubo una
+// escritura durante la copia (seqlock), y decodifica la copia; así las consultas no frenan
+// a los escritores ni entre sí. Solo toma el mutex si una escritura no termina.
+static bool loadMemorySnapshot(json &jsonRAM, json &jsonSwap)
+{
+    if (!sharedTable.isOpen())
+    {
+        return loadJsonFiles(jsonRAM, jsonSwap);
+    }
 
-            // Añadir la página en la tabla de paginación del segmento
-            segmentEntry["pages"][0]["frame_ram"] = ramFrame_id;
-            segmentEntry["pages"][0]["presence_bit"] = 1;
+    SharedHeader *header = sharedTable.getHeader();
+    std::vector<SharedFrame> ram;
+    std::vector<SharedFrame> swap;
+    std::vector<uint8_t> tables;
+    for (;;)
+    {
+        uint32_t sequence;
+        if (!sharedTable.beginRead(sequence))
+        {
+            MemoryLock lock;
+            return loadSharedJson(jsonRAM, jsonSwap);
+        }
+        ram.assign(sharedTable.ramFrames(), sharedTable.ramFrames() + header->ram_frames);
+        swap.assign(sharedTable.swapFrames(), sharedTable.swapFrames() + header->swap_frames);
+        // Una copia a medias puede tener cualquier tamaño: se acota antes de copiar
+        uint32_t tablesSize = std::min(header->tables_size, header->tables_capacity);
+        tables.assign(sharedTable.tables(), sharedTable.tables() + tablesSize);
+        if (sharedTable.validateRead(sequence))
+        {
+            break;
         }
+    }
+    return decodeSharedJson(ram.data(), static_cast<uint32_t>(ram.size()), swap.data(), static_cast<uint32_t>(swap.size()),
+                            tables.data(), static_cast<uint32_t>(tables.size()), jsonRAM, jsonSwap);
+}
+
+// Función para saber si un frame libre todavía tiene el contenido de su página anterior
+static bool needsZeroing(const json &frame)
+{
+    return frame.contains("content") && !frame["content"].get_ref<const std::string &>().empty();
+}
 
-        // Añadir el segmento con sus páginas a la entrada del proceso
-        processEntry["segments"].push_back(segmentEntry);
+// Función para guardar el estado de memoria en la memoria compartida o en los archivos JSON.
+// Las dos formas escriben primero las páginas pendientes en Swap y después las tablas que
+// apuntan a ellas, y no escriben nada si las tablas no se pueden guardar. Los frames de RAM
+// liberados en la operación se limpian acá, en la misma pasada que guarda el estado, así su
+// contenido no queda en RAM.json ni en la memoria compartida.
+static bool saveMemoryJson(json &jsonRAM, const json &jsonSwap, bool swapChanged = true)
+{
+    for (auto &frame : jsonRAM["frames"])
+    {
+        if (frame["is_free"] && needsZeroing(frame))
+        {
+            frame["content"] = "";
+            zeroPoolStats.frames_zeroed++;
+        }
     }
-    // Agregar la entrada del proceso a la lista de procesos en RAM
-    jsonRAM["SO"].push_back(processEntry);
+    if (sharedTable.isOpen())
+    {
+        return saveSharedJson(jsonRAM, jsonSwap, swapChanged);
+    }
+    return saveJsonFiles(jsonRAM, jsonSwap, swapChanged);
+}
 
-    // Guardar los JSON actualizados en sus archivos correspondientes
-    std::ofstream archivoPrincipalJsonSalida(jsonRAMPath);
-    if (archivoPrincipalJsonSalida.is_open())
+// Método para calcular la memoria libre de todo el sistema
+int freeMem()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    vector<Frame> frames;
+    if (sharedTable.isOpen())
+    {
+        for (const auto &shared : readSharedFrames(false, 0, sharedTable.getHeader()->ram_frames))
+        {
+            frames.push_back(toFrame(shared));
+        }
+    }
+    else
     {
-        archivoPrincipalJsonSalida << jsonRAM.dump(4); // Escribir el JSON principal formateado con 4 espacios
-        archivoPrincipalJsonSalida.close();
+        frames = loadFramesFromJson(jsonRAMPath);
     }
+    MemoryCalculator memoryCalculator(frames);
+    int available_memory = memoryCalculator.calculateAvailableMemory();
+    return available_memory;
+}
 
-    std::ofstream archivoSecundarioJsonSalida(jsonSwapPath);
-    if (archivoSecundarioJsonSalida.is_open())
+// Método para obtener el número total de frames de RAM del sistema
+int ramFrameCount()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    if (sharedTable.isOpen())
     {
-        archivoSecundarioJsonSalida << jsonSwap.dump(4); // Escribir el JSON secundario formateado con 4 espacios
-        archivoSecundarioJsonSalida.close();
+        return static_cast<int>(sharedTable.getHeader()->ram_frames);
     }
+    return static_cast<int>(loadFramesFromJson(jsonRAMPath).size());
+}
 
-    std::cout << "JSON principal y secundario actualizados correctamente." << std::endl;
+// Función para dividir una cadena en páginas de un tamaño específico
+vector<string> pagination(const string &text, int size)
+{
+    vector<string> pages;
+    for (size_t i = 0; i < text.size(); i += size)
+    {
+        pages.push_back(text.substr(i, size));
+    }
+    return pages;
 }
 
-// Función para dividir el archivo en segment y pages
-bool memoryAllocation(int process_id) // solo pid
+// Función usada para contar el numero de lineas de un archivo
+int countLines(const string &filePath)
 {
     ifstream archivo(filePath);
-    int segmentSize = ceil(countLines(filePath) / 3.0); // Número de líneas por parte
-    int pageSize = 50;
-
     if (!archivo.is_open())
     {
         cerr << "No se pudo abrir el archivo: " << filePath << endl;
-        return {};
+        return -1; // Devuelve -1 si no se puede abrir el archivo
     }
 
-    vector<vector<string>> segment;
-    vector<string> currentSegment;
-    string line;
-    int lineCounter = 0;
+    int line_counter = 0;
+    string linea;
 
-    while (getline(archivo, line))
+    while (getline(archivo, linea))
     {
-        currentSegment.push_back(line);
-        lineCounter++;
+        line_counter++;
+    }
 
-        // Si alcanzamos el límite de líneas por parte, procesamos la parte
-        if (lineCounter == segmentSize)
+    archivo.close();
+    return line_counter;
+}
+
+// Hash FNV-1a de 64 bits; hash permite encadenar varios textos
+static uint64_t hashText(const string &text, uint64_t hash = 14695981039346656037ULL)
+{
+    for (unsigned char c : text)
+    {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Función para marcar un frame como libre. El contenido de un frame de RAM no se limpia acá
+// sino al guardar la operación (saveMemoryJson), así un frame que la misma operación vuelve
+// a usar se sobrescribe sin haberse limpiado. Los frames de Swap no tienen contenido.
+static void clearFrame(json &frame)
+{
+    frame["is_free"] = true;  // Indicar página libre
+    frame["segment_id"] = 0;  // Reiniciar segment_id
+    frame["page_number"] = 0; // Reiniciar page_number
+}
+
+// Función para liberar solo los frames de la lista de un proceso, O(frames propios)
+static void releaseOwnedFrames(json &frames, const json &ownedFrames, int process_id)
+{
+    for (const auto &frame_number : ownedFrames)
+    {
+        size_t index = frame_number.get<size_t>();
+        if (index < frames.size() && frames[index]["process_id"] == process_id && !frames[index]["is_free"])
         {
-            vector<string> pages;
-            string segmentString;
-            for (const auto &l : currentSegment)
-            {
-                segmentString += l + "\n";
-            }
-            auto pageInProgress = pagination(segmentString, pageSize);
-            pages.insert(pages.end(), pageInProgress.begin(), pageInProgress.end());
-            segment.push_back(pages);
-            currentSegment.clear();
-            lineCounter = 0;
+            clearFrame(frames[index]);
         }
     }
+}
 
-    // Procesar la última parte si quedó incompleta
-    if (!currentSegment.empty())
+// Función para quitar un frame de la lista de frames propios de un proceso
+static void removeOwnedFrame(json &ownedFrames, int frame_number)
+{
+    for (auto it = ownedFrames.begin(); it != ownedFrames.end(); ++it)
     {
-        vector<string> pages;
-        for (const auto &l : currentSegment)
+        if (*it == frame_number)
         {
-            auto pageInProgress = pagination(l, pageSize);
-            pages.insert(pages.end(), pageInProgress.begin(), pageInProgress.end());
+            ownedFrames.erase(it);
+            return;
         }
-        segment.push_back(pages);
     }
-
-    archivo.close();
-    uploadToRam(segment, process_id);
-    return true;
 }
 
-string getPage(int frame_number)
+// Función para buscar la tabla de un proceso en el JSON principal. Los ids negativos
+// son segmentos compartidos, que tienen la misma forma que la tabla de un proceso.
+static json *findProcessEntry(json &jsonRAM, int process_id)
 {
-    ifstream inputFile(jsonSwapPath);
-    json jsonData;
-    inputFile >> jsonData;
-    inputFile.close();
+    const char *list = process_id < 0 ? "shared_segments" : "SO";
+    if (!jsonRAM.contains(list))
+    {
+        return nullptr;
+    }
+    for (auto &process : jsonRAM[list])
+    {
+        if (process["process_id"] == process_id)
+        {
+            return &process;
+        }
+    }
+    return nullptr;
+}
 
-    string content;
-    // Busca el frame que tiene la página y obtiene el contenido
-    for (auto &frame : jsonData["frames"])
+// Función para obtener todas las tablas con páginas: las de los procesos y las de los
+// segmentos compartidos
+static std::vector<const json *> pageTables(const json &jsonRAM)
+{
+    std::vector<const json *> tables;
+    for (const auto &process : jsonRAM["SO"])
     {
-        if (frame["frame_number"] == frame_number)
+        tables.push_back(&process);
+    }
+    if (jsonRAM.contains("shared_segments"))
+    {
+        for (const auto &shared : jsonRAM["shared_segments"])
         {
-            content = frame["content"];
-            break;
+            tables.push_back(&shared);
         }
     }
+    return tables;
+}
 
-    return content;
+// Función para obtener la tabla que tiene las páginas de un segmento: la del propio
+// proceso o, si el segmento es compartido, la del segmento compartido
+static json *findSegmentOwner(json &jsonRAM, json &processEntry, int segmento)
+{
+    for (auto &segmentos : processEntry["segments"])
+    {
+        if (segmentos["segment_id"] == segmento && segmentos.contains("shared_id"))
+        {
+            return findProcessEntry(jsonRAM, segmentos["shared_id"]);
+        }
+    }
+    return &processEntry;
 }
 
-void updateTable(int segmento, int pagina, int process_id, int new_page_ram_frame)
+// Función para saber si un segmento de un proceso es de solo lectura
+static bool isReadOnlySegment(const json &processEntry, int segmento)
 {
-    ifstream inputFile(jsonRAMPath);
-    json jsonData;
-    inputFile >> jsonData;
-    inputFile.close();
+    for (const auto &segmentos : processEntry["segments"])
+    {
+        if (segmentos["segment_id"] == segmento)
+        {
+            return segmentos.value("read_only", false);
+        }
+    }
+    return false;
+}
 
-    for (auto &process : jsonData["SO"])
+// Función para buscar la entrada de una página en la tabla de un proceso
+static json *findPageEntry(json &processEntry, int segmento, int pagina)
+{
+    for (auto &segmentos : processEntry["segments"])
     {
-        if (process["process_id"] == process_id)
+        if (segmentos["segment_id"] == segmento)
         {
-            for (auto &segmentos : process["segments"])
+            for (auto &paginas : segmentos["pages"])
             {
-                if (segmentos["segment_id"] == segmento)
+                if (paginas["page_number"] == pagina)
                 {
-                    for (auto &paginas : segmentos["pages"])
-                    {
-                        if (paginas["page_number"] == pagina)
-                        {
-                            paginas["frame_ram"] = new_page_ram_frame;
-                            paginas["presence_bit"] = 1;
-                        }
-                    }
+                    return &paginas;
                 }
             }
         }
     }
-
-    // Guarda el archivo JSON con los cambios
-    ofstream outputFile(jsonRAMPath);
-    outputFile << jsonData.dump(4);
-    outputFile.close();
+    return nullptr;
 }
 
-bool memorySwap(int segmento, int pagina, int process_id)
+static int countFreeFrames(const json &frames)
 {
-    ifstream inputFile(jsonRAMPath);
-    json jsonData;
-    inputFile >> jsonData;
-    inputFile.close();
+    int free_frames = 0;
+    for (const auto &frame : frames)
+    {
+        if (frame["is_free"])
+        {
+            free_frames++;
+        }
+    }
+    return free_frames;
+}
 
-    int frame_number_swap = 0;
-    int frame_number_Ram = 0;
-    for (auto &process : jsonData["SO"])
+// Función para obtener un frame libre desde from, o -1 si no hay ninguno. Se prefieren los
+// liberados en esta misma operación, que todavía tienen su contenido: quien pide el frame lo
+// sobrescribe, así ya no hay que limpiarlo al guardar. Si no hay, se toma uno del pool.
+static int takeFreeFrame(json &frames, size_t from = 0)
+{
+    int pooled = -1;
+    for (size_t i = from; i < frames.size(); ++i)
     {
-        if (process["process_id"] == process_id)
+        if (frames[i]["is_free"])
         {
-            for (auto &segmentos : process["segments"])
+            if (needsZeroing(frames[i]))
             {
-                if (segmentos["segment_id"] == segmento)
-                {
-                    for (auto &paginas : segmentos["pages"])
-                    {
-                        if (paginas["page_number"] == pagina)
-                        {
-                            frame_number_swap = paginas["frame_swap"];
-                        }
-                        if (paginas["presence_bit"] == 1)
-                        {
-                            frame_number_Ram = paginas["frame_ram"];
-                            paginas["frame_ram"] = -1;
-                            paginas["presence_bit"] = 0;
-                        }
-                    }
-                }
+                zeroPoolStats.reused_frames++;
+                return static_cast<int>(i);
             }
+            pooled = pooled < 0 ? static_cast<int>(i) : pooled;
         }
     }
-    int new_ram_frame_assigned = 0;
-    bool assigned = false;
-    for (auto &frame : jsonData["frames"])
+    if (pooled >= 0)
+    {
+        zeroPoolStats.pool_hits++;
+    }
+    return pooled;
+}
+
+// Función para sacar de RAM una página residente. Las páginas limpias están en la caché
+// de Swap (su copia de Swap sigue vigente) y se descartan sin escribir. Una página sucia
+// se escribe en su slot del archivo de Swap, salvo que su contenido haya vuelto a ser igual
+// al de la copia: se compara con el hash de la copia guardado al traer la página (swap_hash),
+// sin leer el slot.
+static void evictPage(json &jsonRAM, json &processEntry, json &pageEntry)
+{
+    int frame_number = pageEntry["frame_ram"];
+    int segment_id = jsonRAM["frames"][frame_number]["segment_id"];
+    bool wroteBack = false;
+    if (pageEntry.value("dirty_bit", 0) == 1)
     {
-        if (frame["is_free"] && !assigned)
+        const std::string &ramContent = jsonRAM["frames"][frame_number]["content"].get_ref<const std::string &>();
+        int slot = pageEntry["frame_swap"];
+        if (pageEntry.contains("swap_hash") && pageEntry["swap_hash"].get<uint64_t>() == hashText(ramContent))
         {
-            frame["is_free"] = false;       // Actualizar is_free
-            frame["segment_id"] = segmento; // Reiniciar segment_id
-            frame["page_number"] = pagina;  // Reiniciar page_number
-            frame["content"] = getPage(frame_number_swap);
-            new_ram_frame_assigned = frame["frame_number"];
-            assigned = true;
+            writebackStats.writebacks_identical++;
         }
-        if (frame["frame_number"] == frame_number_Ram)
+        else if (stageSwapWrite(slot, ramContent))
         {
-            frame["is_free"] = true;  // Actualizar is_free
-            frame["segment_id"] = 0;  // Reiniciar segment_id
-            frame["page_number"] = 0; // Reiniciar page_number
-            frame["content"] = "";    // Limpiar contenido
+            writebackStats.writebacks++;
+            bytesWrittenBack += ramContent.size();
+            wroteBack = true;
         }
     }
+    else
+    {
+        writebackStats.writebacks_avoided++;
+    }
 
-    // Guarda el archivo JSON con los cambios
-    ofstream outputFile(jsonRAMPath);
-    outputFile << jsonData.dump(4);
-    outputFile.close();
+    evictions++;
+    memoryTrace.record(MemoryEventType::Eviction, processEntry["process_id"], segment_id, pageEntry["page_number"],
+                       frame_number, pageEntry["frame_swap"], wroteBack ? MEMORY_EVENT_WRITEBACK : 0);
+    clearFrame(jsonRAM["frames"][frame_number]);
+    if (processEntry.contains("ram_frames"))
+    {
+        removeOwnedFrame(processEntry["ram_frames"], frame_number);
+    }
+    pageEntry["frame_ram"] = -1;
+    pageEntry["presence_bit"] = 0;
+    pageEntry["referenced_bit"] = 0;
+    pageEntry["dirty_bit"] = 0;
+    pageEntry.erase("swap_hash");
+}
 
-    updateTable(segmento, pagina, process_id, new_ram_frame_assigned);
-    return true;
+// Función para desalojar páginas frías hasta tener targetFree frames libres. Recorre
+// la RAM como un reloj con segunda oportunidad: la manecilla avanza desde donde quedó
+// en la llamada anterior y las páginas con referenced_bit lo pierden en lugar de salir.
+// Devuelve los frames liberados.
+static int reclaimFrames(json &jsonRAM, int targetFree)
+{
+    auto &frames = jsonRAM["frames"];
+    int total = static_cast<int>(frames.size());
+    int free_frames = countFreeFrames(frames);
+    int reclaimed = 0;
+
+    // Dos vueltas bastan: en la primera se limpian los bits de referencia
+    for (int scanned = 0; scanned < 2 * total && free_frames < targetFree; ++scanned)
+    {
+        int frame_number = reclaimHand;
+        reclaimHand = (reclaimHand + 1) % total;
+        reclaimStats.pages_scanned++;
+
+        auto &frame = frames[frame_number];
+        if (frame["is_free"])
+        {
+            continue;
+        }
+
+        json *process = findProcessEntry(jsonRAM, frame["process_id"]);
+        json *page = process ? findPageEntry(*process, frame["segment_id"], frame["page_number"]) : nullptr;
+        if (page == nullptr || (*page)["frame_ram"] != frame_number)
+        {
+            continue; // Frame sin entrada en las tablas (proceso a medio cargar)
+        }
+
+        if (page->value("referenced_bit", 0) == 1)
+        {
+            (*page)["referenced_bit"] = 0; // Segunda oportunidad
+            continue;
+        }
+
+        evictPage(jsonRAM, *process, *page);
+        free_frames++;
+        reclaimed++;
+    }
+
+    reclaimStats.pages_reclaimed += reclaimed;
+    return reclaimed;
+}
+
+// Función para despertar al reclaimer si la RAM quedó por debajo de la marca baja
+static void wakeReclaimerIfLow(const json &frames)
+{
+    if (reclaimStats.running && countFreeFrames(frames) < reclaimStats.low_watermark)
+    {
+        reclaimer.wakeup.notify_one();
+    }
+}
+
+// Función para quitar una referencia a un segmento compartido y liberarlo si era la última
+static void releaseSharedSegment(json &jsonRAM, json &jsonSwap, int shared_id)
+{
+    auto &sharedEntries = jsonRAM["shared_segments"];
+    for (auto it = sharedEntries.begin(); it != sharedEntries.end(); ++it)
+    {
+        if ((*it)["process_id"] == shared_id)
+        {
+            int refcount = (*it)["refcount"].get<int>() - 1;
+            (*it)["refcount"] = refcount;
+            if (refcount <= 0)
+            {
+                releaseOwnedFrames(jsonRAM["frames"], (*it)["ram_frames"], shared_id);
+                releaseOwnedFrames(jsonSwap["frames"], (*it)["swap_frames"], shared_id);
+                sharedEntries.erase(it);
+            }
+            return;
+        }
+    }
+}
+
+// Función para liberar los frames y la tabla de un proceso sobre los JSON ya cargados
+static void releaseProcess(json &jsonRAM, json &jsonSwap, int process_id)
+{
+    // Buscar la tabla del proceso; solo se tocan los frames que le pertenecen
+    auto &soEntries = jsonRAM["SO"];
+    auto processIt = std::find_if(soEntries.begin(), soEntries.end(),
+                                  [process_id](const json &item)
+                                  { return item["process_id"] == process_id; });
+
+    if (processIt != soEntries.end() && processIt->contains("ram_frames") && processIt->contains("swap_frames"))
+    {
+        releaseOwnedFrames(jsonRAM["frames"], (*processIt)["ram_frames"], process_id);
+        releaseOwnedFrames(jsonSwap["frames"], (*processIt)["swap_frames"], process_id);
+    }
+    else
+    {
+        // Tablas antiguas sin lista de frames propios: recorrer todos los frames
+        for (auto &frame : jsonRAM["frames"])
+        {
+            if (frame["process_id"] == process_id && !frame["is_free"])
+            {
+                clearFrame(frame);
+            }
+        }
+        for (auto &frame : jsonSwap["frames"])
+        {
+            if (frame["process_id"] == process_id && !frame["is_free"])
+            {
+                clearFrame(frame);
+            }
+        }
+    }
+
+    // Soltar los segmentos compartidos; sus frames se liberan con la última referencia
+    if (processIt != soEntries.end())
+    {
+        for (const auto &segmentos : (*processIt)["segments"])
+        {
+            if (segmentos.contains("shared_id"))
+            {
+                releaseSharedSegment(jsonRAM, jsonSwap, segmentos["shared_id"]);
+            }
+        }
+    }
+
+    // Borrar la tabla de direcciones asociada al proceso
+    if (processIt != soEntries.end())
+    {
+        soEntries.erase(processIt);
+    }
+}
+
+// Función usada para liberar la memoria de un proceso
+void releaseMemory(int process_id)
+{
+    OperationTimer timer(MemoryOperation::Release);
+    MemoryLock lock;
+    json jsonRAM;
+    json jsonSwap;
+    if (!loadMemoryJson(jsonRAM, jsonSwap))
+    {
+        return;
+    }
+
+    releaseProcess(jsonRAM, jsonSwap, process_id);
+
+    if (!saveMemoryJson(jsonRAM, jsonSwap))
+    {
+        return;
+    }
+    memoryTrace.record(MemoryEventType::Free, process_id, 0, 0);
+
+    std::cout << "Memoria liberada en JSON principal y secundario para process_id: " << process_id << std::endl;
+}
+
+// Función para reservar count slots de Swap en los dispositivos más rápidos con lugar.
+// Dentro de un dispositivo se prefiere un bloque contiguo que empiece al inicio de un
+// cluster y luego cualquier bloque contiguo. Los dispositivos de igual prioridad se turnan
+// (striping): cada reserva empieza por el siguiente del turno, y si ninguno tiene el bloque
+// contiguo las páginas se reparten de a una entre ellos. Si ningún grupo de prioridad tiene
+// lugar para todas, se toman los slots libres de mayor a menor prioridad. preferred es un
+// slot que conviene usar para una sola página si está libre y su dispositivo es de los más
+// rápidos con lugar. Devuelve false si no hay suficientes.
+static bool allocateSwapSlots(const json &swapFrames, size_t count, std::vector<int> &slots, int preferred = -1)
+{
+    slots.clear();
+    if (count == 0)
+    {
+        return true;
+    }
+
+    // Longitud del bloque libre que empieza en start sin pasar de end (ni de count)
+    auto freeRunAt = [&swapFrames, count](size_t start, size_t end)
+    {
+        size_t length = 0;
+        while (start + length < end && length < count && swapFrames[start + length]["is_free"])
+        {
+            length++;
+        }
+        return length;
+    };
+    auto contiguousIn = [&](const SwapDevice &device)
+    {
+        size_t first = static_cast<size_t>(device.first_slot);
+        size_t end = first + static_cast<size_t>(device.slots);
+        for (size_t step : {static_cast<size_t>(SWAP_CLUSTER_SIZE), static_cast<size_t>(1)})
+        {
+            for (size_t start = first; start + count <= end; start += step)
+            {
+                if (freeRunAt(start, end) == count)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        slots.push_back(static_cast<int>(start + i));
+                    }
+                    return true;
+                }
+            }
+        }
+        return false;
+    };
+    auto freeSlotsIn = [&swapFrames](const SwapDevice &device)
+    {
+        size_t free_slots = 0;
+        for (int i = device.first_slot; i < device.first_slot + device.slots; ++i)
+        {
+            free_slots += swapFrames[i]["is_free"] ? 1 : 0;
+        }
+        return free_slots;
+    };
+
+    std::map<int, std::vector<SwapDevice *>, std::greater<int>> groups;
+    for (auto &device : swapDevices)
+    {
+        groups[device->priority].push_back(device.get());
+    }
+
+    for (auto &group : groups)
+    {
+        auto &devices = group.second;
+        size_t free_slots = 0;
+        for (SwapDevice *device : devices)
+        {
+            free_slots += freeSlotsIn(*device);
+        }
+        if (free_slots == 0)
+        {
+            continue;
+        }
+
+        SwapDevice *preferredDevice = deviceForSlot(preferred);
+        if (count == 1 && preferredDevice != nullptr && preferredDevice->priority == group.first &&
+            swapFrames[preferred]["is_free"])
+        {
+            slots.push_back(preferred);
+            return true;
+        }
+        if (free_slots < count)
+        {
+            continue;
+        }
+
+        size_t &cursor = stripeCursor[group.first];
+        for (size_t k = 0; k < devices.size(); ++k)
+        {
+            size_t index = (cursor + k) % devices.size();
+            if (contiguousIn(*devices[index]))
+            {
+                cursor = (index + 1) % devices.size();
+                return true;
+            }
+        }
+
+        // Sin bloque contiguo en ningún dispositivo: las páginas se reparten de a una
+        std::vector<int> next;
+        for (SwapDevice *device : devices)
+        {
+            next.push_back(device->first_slot);
+        }
+        for (size_t k = cursor; slots.size() < count; ++k)
+        {
+            size_t index = k % devices.size();
+            int end = devices[index]->first_slot + devices[index]->slots;
+            while (next[index] < end && !swapFrames[next[index]]["is_free"])
+            {
+                next[index]++;
+            }
+            if (next[index] < end)
+            {
+                slots.push_back(next[index]++);
+            }
+        }
+        cursor = (cursor + 1) % devices.size();
+        return true;
+    }
+
+    // Ningún grupo alcanza solo: la Swap está casi llena
+    for (auto &group : groups)
+    {
+        for (SwapDevice *device : group.second)
+        {
+            for (int i = device->first_slot; i < device->first_slot + device->slots && slots.size() < count; ++i)
+            {
+                if (swapFrames[i]["is_free"])
+                {
+                    slots.push_back(i);
+                }
+            }
+        }
+    }
+    return slots.size() == count;
+}
+
+// Función para ubicar las páginas de un segmento: todas en Swap y la primera también en
+// RAM. owner es la tabla dueña de los frames (un proceso o un segmento compartido).
+// Con source (el programa del que salió) la carga es perezosa: las páginas quedan sin
+// materializar (frame_swap -1) y reciben sus frames en el primer acceso.
+static bool placeSegment(json &jsonRAM, json &jsonSwap, json &owner, int segment_id,
+                         const std::vector<std::string> &pages, size_t &ramFrame_id, const json *source)
+{
+    int owner_id = owner["process_id"];
+
+    // Crear las tablas de paginación para este segmento
+    json segmentEntry;
+    segmentEntry["segment_id"] = segment_id;
+    segmentEntry["pages"] = json::array();
+
+    if (source != nullptr)
+    {
+        segmentEntry["source"] = *source;
+        for (size_t j = 0; j < pages.size(); ++j)
+        {
+            json pageEntry;
+            pageEntry["page_number"] = static_cast<int>(j + 1);
+            pageEntry["frame_swap"] = -1;
+            pageEntry["frame_ram"] = -1;
+            pageEntry["presence_bit"] = 0;
+            pageEntry["referenced_bit"] = 0;
+            pageEntry["dirty_bit"] = 0;
+            segmentEntry["pages"].push_back(pageEntry);
+        }
+        owner["segments"].push_back(segmentEntry);
+        return true;
+    }
+
+    // Reservar en Swap un bloque contiguo para todas las páginas del segmento
+    std::vector<int> swapSlots;
+    if (!allocateSwapSlots(jsonSwap["frames"], pages.size(), swapSlots))
+    {
+        std::cerr << "Memoria Swap Insuficiente" << std::endl;
+        return false;
+    }
+
+    // Guardar las paginas restantes en el JSON secundario
+    for (size_t j = 0; j < pages.size(); ++j)
+    {
+        int swapFrame_id = swapSlots[j];
+
+        // El contenido va al slot del archivo de Swap (al guardar) y el resto a la entrada del
+        // JSON secundario
+        if (!stageSwapWrite(swapFrame_id, pages[j]))
+        {
+            return false;
+        }
+        jsonSwap["frames"][swapFrame_id]["segment_id"] = segment_id;
+        jsonSwap["frames"][swapFrame_id]["page_number"] = static_cast<int>(j + 1);
+        jsonSwap["frames"][swapFrame_id]["process_id"] = owner_id;
+        jsonSwap["frames"][swapFrame_id]["is_free"] = false; // Marcar como ocupado
+        owner["swap_frames"].push_back(swapFrame_id);
+
+        // Añadir la página en la tabla de paginación del segmento
+        json pageEntry;
+        pageEntry["page_number"] = static_cast<int>(j + 1);
+        pageEntry["frame_swap"] = swapFrame_id;
+        pageEntry["frame_ram"] = -1;
+        pageEntry["presence_bit"] = 0;
+        pageEntry["referenced_bit"] = 0;
+        pageEntry["dirty_bit"] = 0;
+        segmentEntry["pages"].push_back(pageEntry);
+    }
+
+    // Guardar la primera subparte en el JSON principal
+    if (!pages.empty())
+    {
+        // Buscar el próximo campo "libre" en el JSON principal
+        while (ramFrame_id < jsonRAM["frames"].size() && jsonRAM["frames"][ramFrame_id]["is_free"] == false)
+        {
+            ramFrame_id++; // Saltar campos ocupados
+        }
+
+        int frame_number = takeFreeFrame(jsonRAM["frames"], ramFrame_id);
+        if (frame_number < 0)
+        {
+            std::cerr << "Memoria RAM Insuficiente" << std::endl;
+            return false;
+        }
+
+        // Actualizar la entrada correspondiente en el JSON principal
+        jsonRAM["frames"][frame_number]["segment_id"] = segment_id;
+        jsonRAM["frames"][frame_number]["page_number"] = 1;
+        jsonRAM["frames"][frame_number]["content"] = pages[0];
+        jsonRAM["frames"][frame_number]["process_id"] = owner_id;
+        jsonRAM["frames"][frame_number]["is_free"] = false;
+        owner["ram_frames"].push_back(frame_number);
+
+        // Añadir la página en la tabla de paginación del segmento
+        segmentEntry["pages"][0]["frame_ram"] = frame_number;
+        segmentEntry["pages"][0]["swap_hash"] = hashText(pages[0]);
+        segmentEntry["pages"][0]["presence_bit"] = 1;
+        segmentEntry["pages"][0]["referenced_bit"] = 1;
+    }
+
+    // Añadir el segmento con sus páginas a la tabla dueña
+    owner["segments"].push_back(segmentEntry);
+    return true;
+}
+
+// Función para obtener el segmento compartido con ese contenido, creándolo si no existe.
+// Devuelve su id (negativo) o 0 si no hubo memoria para cargarlo.
+static int acquireSharedSegment(json &jsonRAM, json &jsonSwap, int segment_id,
+                                const std::vector<std::string> &pages, size_t &ramFrame_id, const json *source)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (const auto &page : pages)
+    {
+        hash = hashText(page, hash);
+        hash = hashText(string(1, '\0'), hash); // Separador para que el corte de páginas cuente
+    }
+    char key[32];
+    std::snprintf(key, sizeof(key), "%016llx:%zu", static_cast<unsigned long long>(hash), pages.size());
+
+    if (!jsonRAM.contains("shared_segments"))
+    {
+        jsonRAM["shared_segments"] = json::array();
+    }
+    int shared_id = -1;
+    for (auto &shared : jsonRAM["shared_segments"])
+    {
+        if (shared["key"] == key && shared["segments"][0]["segment_id"] == segment_id)
+        {
+            shared["refcount"] = shared["refcount"].get<int>() + 1;
+            return shared["process_id"];
+        }
+        shared_id = std::min(shared_id, shared["process_id"].get<int>() - 1);
+    }
+
+    // Primera carga: el segmento compartido tiene la misma forma que la tabla de un proceso
+    json sharedEntry;
+    sharedEntry["process_id"] = shared_id;
+    sharedEntry["key"] = key;
+    sharedEntry["refcount"] = 1;
+    sharedEntry["segments"] = json::array();
+    sharedEntry["ram_frames"] = json::array();
+    sharedEntry["swap_frames"] = json::array();
+    if (!placeSegment(jsonRAM, jsonSwap, sharedEntry, segment_id, pages, ramFrame_id, source))
+    {
+        return 0;
+    }
+    jsonRAM["shared_segments"].push_back(sharedEntry);
+    return shared_id;
+}
+
+// Función para ubicar los segmentos de un proceso sobre los JSON ya cargados. El segmento
+// de código es de solo lectura y se comparte entre los procesos que cargan el mismo programa.
+// Con source la carga es perezosa (ver placeSegment).
+// Devuelve false si no hay memoria suficiente; en ese caso los JSON quedan a medio
+// modificar y el llamador debe descartarlos.
+static bool placeProcess(json &jsonRAM, json &jsonSwap, const std::vector<std::vector<std::string>> &segments, int process_id,
+                         const json *source = nullptr)
+{
+    // Si el proceso ya existe se libera su memoria antes de volver a cargarlo
+    releaseProcess(jsonRAM, jsonSwap, process_id);
+
+    size_t ramFrame_id = 0;
+
+    // Crear un objeto para el proceso en el JSON principal
+    json processEntry;
+    processEntry["process_id"] = process_id;  // El ID del proceso
+    processEntry["segments"] = json::array(); // Inicializar el array de segmentos
+    processEntry["ram_frames"] = json::array();  // Frames de RAM que pertenecen al proceso
+    processEntry["swap_frames"] = json::array(); // Frames de Swap que pertenecen al proceso
+
+    // Iterar sobre los segmentos y paginas para organizarlas en los JSON
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        int segment_id = static_cast<int>(i + 1);
+        if (segment_id == TEXT_SEGMENT_ID && !segments[i].empty())
+        {
+            int shared_id = acquireSharedSegment(jsonRAM, jsonSwap, segment_id, segments[i], ramFrame_id, source);
+            if (shared_id == 0)
+            {
+                return false;
+            }
+
+            // El proceso solo guarda la referencia; las páginas están en el segmento compartido
+            json segmentEntry;
+            segmentEntry["segment_id"] = segment_id;
+            segmentEntry["read_only"] = true;
+            segmentEntry["shared_id"] = shared_id;
+            segmentEntry["pages"] = json::array();
+            processEntry["segments"].push_back(segmentEntry);
+        }
+        else if (!placeSegment(jsonRAM, jsonSwap, processEntry, segment_id, segments[i], ramFrame_id, source))
+        {
+            return false;
+        }
+    }
+    // El presupuesto inicial de frames (para PFF) es lo que se le dio al cargarlo
+    processEntry["frame_budget"] = std::max(static_cast<int>(processEntry["ram_frames"].size()), 1);
+
+    // Agregar la entrada del proceso a la lista de procesos en RAM
+    jsonRAM["SO"].push_back(processEntry);
+    return true;
+}
+
+// Función para contar las páginas de un programa segmentado
+static int programPages(const std::vector<std::vector<std::string>> &segments)
+{
+    int pages = 0;
+    for (const auto &segment : segments)
+    {
+        pages += static_cast<int>(segment.size());
+    }
+    return pages;
+}
+
+// Candidato a víctima del OOM. Se elige primero la prioridad más baja, después el que más
+// frames ocupa entre RAM y Swap y, a igualdad, el process_id más alto, así la elección es
+// siempre la misma para el mismo estado.
+struct OomCandidate {
+    int priority;
+    int ram_frames;
+    int swap_frames;
+    int process_id;
+};
+
+// Orden del heap de víctimas: a < b si a es peor víctima que b
+static bool oomLess(const OomCandidate &a, const OomCandidate &b)
+{
+    if (a.priority != b.priority)
+    {
+        return a.priority > b.priority;
+    }
+    if (a.ram_frames + a.swap_frames != b.ram_frames + b.swap_frames)
+    {
+        return a.ram_frames + a.swap_frames < b.ram_frames + b.swap_frames;
+    }
+    return a.process_id < b.process_id;
+}
+
+// Función para armar el heap de víctimas con los frames propios de cada proceso (las listas
+// ram_frames y swap_frames, que se mantienen al asignar y desalojar), sin recorrer sus tablas
+// de páginas. Armarlo es O(n) y sacar cada víctima O(log n). Los frames de segmentos
+// compartidos no se cuentan: terminar a uno de los procesos no los libera.
+static std::vector<OomCandidate> oomCandidates(const json &jsonRAM, const std::vector<int> &excluded)
+{
+    std::vector<OomCandidate> heap;
+    for (const auto &process : jsonRAM["SO"])
+    {
+        int process_id = process["process_id"];
+        if (std::find(excluded.begin(), excluded.end(), process_id) != excluded.end())
+        {
+            continue;
+        }
+        heap.push_back({process.value("priority", 0),
+                        process.contains("ram_frames") ? static_cast<int>(process["ram_frames"].size()) : 0,
+                        process.contains("swap_frames") ? static_cast<int>(process["swap_frames"].size()) : 0,
+                        process_id});
+    }
+    std::make_heap(heap.begin(), heap.end(), oomLess);
+    return heap;
+}
+
+static bool popOomVictim(std::vector<OomCandidate> &heap, OomCandidate &victim)
+{
+    if (heap.empty())
+    {
+        return false;
+    }
+    std::pop_heap(heap.begin(), heap.end(), oomLess);
+    victim = heap.back();
+    heap.pop_back();
+    return true;
+}
+
+// Función para ubicar procesos cuando puede faltar memoria. place los ubica sobre los JSON y
+// devuelve false si no entran; en ese caso se descartan sus cambios a medias. Primero se
+// desalojan páginas de RAM (siempre tienen copia en Swap) hasta tener framesNeeded libres;
+// si aun así no entran es la Swap la que está llena y se termina a la víctima del OOM,
+// liberando su memoria, hasta que entren. Los procesos de loading no se terminan. Si no
+// entran ni sin víctimas no se termina a nadie: los JSON y las escrituras de Swap pendientes
+// quedan como estaban.
+static bool placeWithOom(json &jsonRAM, json &jsonSwap, const std::vector<int> &loading, int framesNeeded,
+                         const std::function<bool(json &, json &)> &place)
+{
+    const json originalRAM = jsonRAM;
+    const json originalSwap = jsonSwap;
+    const size_t originalStaged = stagedSwapWrites.size();
+
+    // Estado desde el que se reintenta: el original más los desalojos y las víctimas
+    json cleanRAM = jsonRAM;
+    json cleanSwap = jsonSwap;
+    size_t cleanStaged = originalStaged;
+    bool reclaimed = false;
+    bool ranked = false;
+    std::vector<OomCandidate> victims;
+    std::vector<OomCandidate> killed;
+    while (!place(jsonRAM, jsonSwap))
+    {
+        jsonRAM = cleanRAM;
+        jsonSwap = cleanSwap;
+        stagedSwapWrites.resize(cleanStaged);
+        if (!reclaimed)
+        {
+            reclaimed = true;
+            if (reclaimFrames(jsonRAM, framesNeeded) > 0)
+            {
+                oomStats.reclaims++;
+                cleanRAM = jsonRAM;
+                cleanStaged = stagedSwapWrites.size(); // Páginas sucias desalojadas
+                continue;
+            }
+        }
+
+        if (!ranked)
+        {
+            victims = oomCandidates(jsonRAM, loading);
+            ranked = true;
+        }
+        OomCandidate victim;
+        if (!popOomVictim(victims, victim))
+        {
+            oomStats.failures++;
+            std::cerr << "Sin memoria: no quedan procesos que terminar, no se terminó ninguno" << std::endl;
+            jsonRAM = originalRAM;
+            jsonSwap = originalSwap;
+            stagedSwapWrites.resize(originalStaged);
+            return false;
+        }
+        releaseProcess(jsonRAM, jsonSwap, victim.process_id);
+        killed.push_back(victim);
+        cleanRAM = jsonRAM;
+        cleanSwap = jsonSwap;
+    }
+
+    for (const auto &victim : killed)
+    {
+        std::cerr << "Sin memoria: se terminó el proceso " << victim.process_id << " (prioridad " << victim.priority
+                  << ", " << victim.ram_frames << " frames de RAM y " << victim.swap_frames << " de Swap)" << std::endl;
+        memoryTrace.record(MemoryEventType::Free, victim.process_id, 0, 0);
+        oomStats.kills++;
+        oomStats.last_victim = victim.process_id;
+    }
+    return true;
+}
+
+// Función para contar los frames de RAM que necesita un programa al cargarse: uno por segmento
+static int framesToLoad(const std::vector<std::vector<std::string>> &segments)
+{
+    int frames = 0;
+    for (const auto &segment : segments)
+    {
+        frames += segment.empty() ? 0 : 1;
+    }
+    return frames;
+}
+
+// Función para cargar un proceso y guardar los JSON. source no nulo pide carga perezosa.
+static bool uploadProgram(const std::vector<std::vector<std::string>> &segments, int process_id, const json *source)
+{
+    MemoryLock lock;
+    // Leer ambos archivos JSON existentes
+    json jsonRAM;
+    json jsonSwap;
+    if (!loadMemoryJson(jsonRAM, jsonSwap))
+    {
+        return false;
+    }
+
+    // Si no hay memoria suficiente ni terminando procesos no se guarda nada, así no quedan
+    // cambios a medias
+    auto place = [&](json &ram, json &swap) { return placeProcess(ram, swap, segments, process_id, source); };
+    if (!placeWithOom(jsonRAM, jsonSwap, {process_id}, framesToLoad(segments), place))
+    {
+        return false;
+    }
+
+    if (!saveMemoryJson(jsonRAM, jsonSwap))
+    {
+        return false;
+    }
+    memoryTrace.record(MemoryEventType::Allocate, process_id, 0, programPages(segments));
+    std::cout << "JSON principal y secundario actualizados correctamente." << std::endl;
+    wakeReclaimerIfLow(jsonRAM["frames"]);
+    return true;
+}
+
+void uploadToRam(const std::vector<std::vector<std::string>> &segments, int process_id)
+{
+    uploadProgram(segments, process_id, nullptr);
+}
+
+// Función para dividir el texto de un programa en segmentos y páginas
+static void parseProgram(const string &text, vector<vector<string>> &segment)
+{
+    int totalLines = 0;
+    {
+        istringstream lines(text);
+        string line;
+        while (getline(lines, line))
+        {
+            totalLines++;
+        }
+    }
+    int segmentSize = ceil(totalLines / 3.0); // Número de líneas por parte
+
+    istringstream archivo(text);
+    vector<string> currentSegment;
+    string line;
+    int lineCounter = 0;
+
+    while (getline(archivo, line))
+    {
+        currentSegment.push_back(line);
+        lineCounter++;
+
+        // Si alcanzamos el límite de líneas por parte, procesamos la parte
+        if (lineCounter == segmentSize)
+        {
+            vector<string> pages;
+            string segmentString;
+            for (const auto &l : currentSegment)
+            {
+                segmentString += l + "\n";
+            }
+            auto pageInProgress = pagination(segmentString, pageSize);
+            pages.insert(pages.end(), pageInProgress.begin(), pageInProgress.end());
+            segment.push_back(pages);
+            currentSegment.clear();
+            lineCounter = 0;
+        }
+    }
+
+    // Procesar la última parte si quedó incompleta
+    if (!currentSegment.empty())
+    {
+        vector<string> pages;
+        for (const auto &l : currentSegment)
+        {
+            auto pageInProgress = pagination(l, pageSize);
+            pages.insert(pages.end(), pageInProgress.begin(), pageInProgress.end());
+        }
+        segment.push_back(pages);
+    }
+}
+
+// Caché de programas ya segmentados. La ruta con su fecha de modificación y tamaño
+// lleva al hash del contenido, y el hash a la imagen, así que un archivo sin cambios
+// no se vuelve a leer y uno tocado pero igual (o copiado a otra ruta) no se vuelve a segmentar.
+// Si el archivo se modificó poco antes de leerlo (menos de PROGRAM_MTIME_TICK), otra escritura
+// justo después puede dejar la misma fecha y tamaño: esa entrada no se da por buena sin volver
+// a leer el archivo y comparar el hash.
+struct ProgramFileEntry {
+    std::filesystem::file_time_type mtime;
+    uintmax_t size;
+    uint64_t hash;
+    std::filesystem::file_time_type read_at; // Hora del reloj de archivos antes de leerlo
+};
+
+using ProgramImage = std::shared_ptr<const vector<vector<string>>>;
+
+struct ProgramImageEntry {
+    ProgramImage image;
+    uint64_t last_use; // Para descartar la imagen usada hace más tiempo
+};
+
+static const size_t PROGRAM_CACHE_LIMIT = 32; // Imágenes guardadas como máximo
+static const auto PROGRAM_MTIME_TICK = std::chrono::seconds(2); // Resolución de fecha más gruesa (FAT)
+static std::mutex programCacheMutex;
+static std::map<std::string, ProgramFileEntry> programFiles;
+static std::map<uint64_t, ProgramImageEntry> programImages;
+static uint64_t programImageUses = 0;
+static ProgramCacheStats programCacheStats;
+
+// Función para descartar la imagen usada hace más tiempo y las rutas que llevan a ella
+static void evictProgramImage()
+{
+    auto oldest = programImages.begin();
+    for (auto it = programImages.begin(); it != programImages.end(); ++it)
+    {
+        if (it->second.last_use < oldest->second.last_use)
+        {
+            oldest = it;
+        }
+    }
+    if (oldest == programImages.end())
+    {
+        return;
+    }
+    for (auto it = programFiles.begin(); it != programFiles.end();)
+    {
+        it = it->second.hash == oldest->first ? programFiles.erase(it) : std::next(it);
+    }
+    programImages.erase(oldest);
+}
+
+// Función para obtener un programa dividido en segmentos y páginas, desde la caché si es
+// posible. contentHash recibe el hash del contenido, que identifica la imagen.
+static bool loadProgram(const string &programPath, ProgramImage &image, uint64_t *contentHash = nullptr)
+{
+    auto readAt = std::filesystem::file_time_type::clock::now();
+    std::error_code error;
+    auto mtime = std::filesystem::last_write_time(programPath, error);
+    uintmax_t size = error ? 0 : std::filesystem::file_size(programPath, error);
+
+    std::lock_guard<std::mutex> lock(programCacheMutex);
+    if (!error)
+    {
+        auto file = programFiles.find(programPath);
+        if (file != programFiles.end() && file->second.mtime == mtime && file->second.size == size &&
+            file->second.read_at - file->second.mtime >= PROGRAM_MTIME_TICK)
+        {
+            auto cached = programImages.find(file->second.hash);
+            if (cached != programImages.end())
+            {
+                programCacheStats.hits++;
+                cached->second.last_use = ++programImageUses;
+                image = cached->second.image;
+                if (contentHash != nullptr)
+                {
+                    *contentHash = file->second.hash;
+                }
+                return true;
+            }
+        }
+    }
+
+    ifstream archivo(programPath);
+    if (!archivo.is_open())
+    {
+        cerr << "No se pudo abrir el archivo: " << programPath << endl;
+        return false;
+    }
+    stringstream buffer;
+    buffer << archivo.rdbuf();
+    string text = buffer.str();
+    archivo.close();
+
+    uint64_t hash = hashText(text);
+    auto cached = programImages.find(hash);
+    if (cached != programImages.end())
+    {
+        programCacheStats.content_hits++;
+        cached->second.last_use = ++programImageUses;
+        image = cached->second.image;
+    }
+    else
+    {
+        if (programImages.size() >= PROGRAM_CACHE_LIMIT)
+        {
+            evictProgramImage();
+        }
+        auto segments = std::make_shared<vector<vector<string>>>();
+        parseProgram(text, *segments);
+        programCacheStats.misses++;
+        image = segments;
+        programImages[hash] = {image, ++programImageUses};
+    }
+
+    // Sin fecha de modificación no se puede saber si el archivo cambió: se vuelve a leer la próxima vez
+    if (!error)
+    {
+        programFiles[programPath] = {mtime, size, hash, readAt};
+    }
+    if (contentHash != nullptr)
+    {
+        *contentHash = hash;
+    }
+    return true;
+}
+
+ProgramCacheStats getProgramCacheStats()
+{
+    std::lock_guard<std::mutex> lock(programCacheMutex);
+    ProgramCacheStats stats = programCacheStats;
+    stats.entries = static_cast<int>(programImages.size());
+    return stats;
+}
+
+void clearProgramCache()
+{
+    std::lock_guard<std::mutex> lock(programCacheMutex);
+    programFiles.clear();
+    programImages.clear();
+}
+
+// Función para describir el programa del que sale un proceso cargado de forma perezosa
+static json programSource(const string &programPath, uint64_t hash)
+{
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+    json source;
+    source["program"] = programPath;
+    source["hash"] = hex;
+    return source;
+}
+
+// Función para contar los bytes de contenido de un programa segmentado
+static uint64_t programBytes(const vector<vector<string>> &segments)
+{
+    uint64_t bytes = 0;
+    for (const auto &pages : segments)
+    {
+        for (const auto &page : pages)
+        {
+            bytes += page.size();
+        }
+    }
+    return bytes;
+}
+
+// Función para dividir el archivo en segment y pages
+bool memoryAllocation(int process_id) // solo pid
+{
+    OperationTimer timer(MemoryOperation::Allocate);
+    ProgramImage segment;
+    uint64_t hash = 0;
+    if (!loadProgram(filePath, segment, &hash))
+    {
+        return {};
+    }
+    timer.bytes = programBytes(*segment);
+
+    json source = programSource(filePath, hash);
+    return uploadProgram(*segment, process_id, lazyAllocation ? &source : nullptr);
+}
+
+void setLazyAllocation(bool enabled)
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    lazyAllocation = enabled;
+}
+
+LazyAllocationStats getLazyAllocationStats()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    LazyAllocationStats stats;
+    stats.enabled = lazyAllocation;
+    stats.pages_materialized = pagesMaterialized;
+    json jsonRAM;
+    json jsonSwap;
+    if (!loadMemorySnapshot(jsonRAM, jsonSwap))
+    {
+        return stats;
+    }
+
+    for (const json *process : pageTables(jsonRAM))
+    {
+        for (const auto &segmentos : (*process)["segments"])
+        {
+            for (const auto &paginas : segmentos["pages"])
+            {
+                if (paginas["frame_swap"] == -1)
+                {
+                    stats.pending_pages++;
+                }
+            }
+        }
+    }
+    return stats;
+}
+
+// Función para asignar memoria a varios procesos a la vez. Cada programa distinto se
+// lee una sola vez, la ubicación se planifica sobre una copia de los JSON y solo se
+// guarda si todos los procesos caben (todo o nada).
+bool allocateBatch(const std::vector<AllocationRequest> &requests)
+{
+    OperationTimer timer(MemoryOperation::AllocateBatch);
+    std::map<std::string, ProgramImage> programs;
+    std::map<std::string, json> sources;
+    for (const auto &request : requests)
+    {
+        const string &programPath = request.programPath.empty() ? filePath : request.programPath;
+        if (programs.count(programPath) == 0)
+        {
+            ProgramImage segment;
+            uint64_t hash = 0;
+            if (!loadProgram(programPath, segment, &hash))
+            {
+                return false;
+            }
+            programs[programPath] = segment;
+            sources[programPath] = programSource(programPath, hash);
+        }
+    }
+
+    MemoryLock lock;
+    json jsonRAM;
+    json jsonSwap;
+    if (!loadMemoryJson(jsonRAM, jsonSwap))
+    {
+        return false;
+    }
+
+    std::vector<int> loading;
+    int framesNeeded = 0;
+    for (const auto &request : requests)
+    {
+        const string &programPath = request.programPath.empty() ? filePath : request.programPath;
+        loading.push_back(request.process_id);
+        framesNeeded += framesToLoad(*programs[programPath]);
+        timer.bytes += programBytes(*programs[programPath]);
+    }
+    auto place = [&](json &ram, json &swap)
+    {
+        for (const auto &request : requests)
+        {
+            const string &programPath = request.programPath.empty() ? filePath : request.programPath;
+            if (!placeProcess(ram, swap, *programs[programPath], request.process_id,
+                              lazyAllocation ? &sources[programPath] : nullptr))
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+    if (!placeWithOom(jsonRAM, jsonSwap, loading, framesNeeded, place))
+    {
+        std::cerr << "No se asignó memoria a ningún proceso del lote" << std::endl;
+        return false;
+    }
+
+    if (!saveMemoryJson(jsonRAM, jsonSwap))
+    {
+        return false;
+    }
+    for (const auto &request : requests)
+    {
+        const string &programPath = request.programPath.empty() ? filePath : request.programPath;
+        memoryTrace.record(MemoryEventType::Allocate, request.process_id, 0, programPages(*programs[programPath]));
+    }
+
+    wakeReclaimerIfLow(jsonRAM["frames"]);
+    std::cout << "Memoria asignada en lote para " << requests.size() << " procesos." << std::endl;
+    return true;
+}
+
+// Función para abrir los dispositivos de Swap la primera vez que se lee sin pasar por las tablas
+static bool ensureSwapFile()
+{
+    if (!swapDevices.empty())
+    {
+        return true;
+    }
+    MemoryLock lock;
+    json jsonRAM;
+    json jsonSwap;
+    return loadMemoryJson(jsonRAM, jsonSwap);
+}
+
+// Función para leer una página de Swap: una sola lectura de su slot, sin cargar los JSON
+string getPage(int frame_number)
+{
+    OperationTimer timer(MemoryOperation::GetPage);
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    string content;
+    if (frame_number < 0 || !ensureSwapFile() || !readSwapSlot(frame_number, content))
+    {
+        return "";
+    }
+    timer.bytes = content.size();
+    return content;
+}
+
+// Función para leer varias páginas contiguas de Swap con una sola lectura por dispositivo.
+// Los segmentos se guardan en bloques contiguos, así que sirve para leer un segmento entero.
+std::vector<std::string> getPages(int first_frame, int count)
+{
+    OperationTimer timer(MemoryOperation::GetPages);
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    std::vector<std::string> contents;
+    if (first_frame < 0 || count <= 0 || !ensureSwapFile())
+    {
+        return contents;
+    }
+
+    timer.bytes = readSwapRange(first_frame, count, contents);
+    return contents;
+}
+
+// Función para reabrir los dispositivos de Swap con o sin E/S directa
+bool setSwapDirectIO(bool enabled)
+{
+    MemoryLock lock;
+    swapDirectIO = enabled;
+    swapDevices.clear();
+    swapReadahead.clear();
+    if (!ensureSwapFile())
+    {
+        return false;
+    }
+    for (const auto &device : swapDevices)
+    {
+        if (device->file.direct() != enabled)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Función para cambiar la lista de dispositivos en el JSON secundario y abrirlos
+static bool saveSwapDevices(json &jsonRAM, json &jsonSwap, const json &devices)
+{
+    jsonSwap["devices"] = devices;
+    bool migrated = false;
+    return prepareSwapFile(jsonSwap, migrated) && saveMemoryJson(jsonRAM, jsonSwap);
+}
+
+static int findSwapDevice(const json &devices, const std::string &path)
+{
+    for (size_t i = 0; i < devices.size(); ++i)
+    {
+        if (devices[i]["path"] == path)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+// Función para agregar un dispositivo de Swap. La cantidad de frames de Swap no cambia: el
+// dispositivo nuevo toma los últimos slots del primero (Swap.dat), que deben estar libres,
+// y queda a continuación de él.
+bool addSwapDevice(const std::string &path, int slots, int priority)
+{
+    MemoryLock lock;
+    json jsonRAM;
+    json jsonSwap;
+    if (!loadMemoryJson(jsonRAM, jsonSwap))
+    {
+        return false;
+    }
+
+    json devices = swapDeviceList(jsonSwap);
+    if (findSwapDevice(devices, path) >= 0)
+    {
+        std::cerr << "El dispositivo de Swap ya existe: " << path << std::endl;
+        return false;
+    }
+    json &base = devices[0];
+    int baseSlots = base["slots"];
+    if (slots <= 0 || slots >= baseSlots)
+    {
+        std::cerr << "El primer dispositivo de Swap tiene " << baseSlots << " slots y debe conservar al menos uno" << std::endl;
+        return false;
+    }
+    for (int i = baseSlots - slots; i < baseSlots; ++i)
+    {
+        if (!jsonSwap["frames"][i]["is_free"])
+        {
+            std::cerr << "Los últimos " << slots << " slots de " << base["path"].get<std::string>() << " deben estar libres" << std::endl;
+            return false;
+        }
+    }
+
+    base["slots"] = baseSlots - slots;
+    devices.insert(devices.begin() + 1, json{{"path", path}, {"priority", priority}, {"slots", slots}});
+    return saveSwapDevices(jsonRAM, jsonSwap, devices);
+}
+
+// Función para quitar un dispositivo de Swap sin páginas: sus slots vuelven al anterior
+bool removeSwapDevice(const std::string &path)
+{
+    MemoryLock lock;
+    json jsonRAM;
+    json jsonSwap;
+    if (!loadMemoryJson(jsonRAM, jsonSwap))
+    {
+        return false;
+    }
+
+    json devices = swapDeviceList(jsonSwap);
+    int index = findSwapDevice(devices, path);
+    if (index <= 0)
+    {
+        std::cerr << (index == 0 ? "No se puede quitar el primer dispositivo de Swap" : "Dispositivo de Swap no encontrado: " + path)
+                  << std::endl;
+        return false;
+    }
+    SwapDevice *device = swapDevices[index].get();
+    for (int i = device->first_slot; i < device->first_slot + device->slots; ++i)
+    {
+        if (!jsonSwap["frames"][i]["is_free"])
+        {
+            std::cerr << "El dispositivo de Swap todavía tiene páginas: " << path << std::endl;
+            return false;
+        }
+    }
+
+    devices[index - 1]["slots"] = devices[index - 1]["slots"].get<int>() + devices[index]["slots"].get<int>();
+    devices.erase(devices.begin() + index);
+    return saveSwapDevices(jsonRAM, jsonSwap, devices);
+}
+
+bool setSwapDevicePriority(const std::string &path, int priority)
+{
+    MemoryLock lock;
+    json jsonRAM;
+    json jsonSwap;
+    if (!loadMemoryJson(jsonRAM, jsonSwap))
+    {
+        return false;
+    }
+
+    json devices = swapDeviceList(jsonSwap);
+    int index = findSwapDevice(devices, path);
+    if (index < 0)
+    {
+        std::cerr << "Dispositivo de Swap no encontrado: " << path << std::endl;
+        return false;
+    }
+    devices[index]["priority"] = priority;
+    return saveSwapDevices(jsonRAM, jsonSwap, devices);
+}
+
+// Función para obtener el uso y las latencias de cada dispositivo de Swap
+std::vector<SwapDeviceStatus> getSwapDevices()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    std::vector<SwapDeviceStatus> report;
+    json jsonRAM;
+    json jsonSwap;
+    if (!loadMemorySnapshot(jsonRAM, jsonSwap))
+    {
+        return report;
+    }
+
+    for (const auto &device : swapDevices)
+    {
+        SwapDeviceStatus status;
+        status.path = device->path;
+        status.priority = device->priority;
+        status.first_slot = device->first_slot;
+        status.slots = device->slots;
+        for (int i = device->first_slot; i < device->first_slot + device->slots; ++i)
+        {
+            status.used_slots += jsonSwap["frames"][i]["is_free"] ? 0 : 1;
+        }
+        status.direct_io = device->file.direct();
+        status.reads = device->reads.count.load(std::memory_order_relaxed);
+        status.writes = device->writes.count.load(std::memory_order_relaxed);
+        status.read_avg_ns = status.reads > 0 ? device->reads.total_ns.load(std::memory_order_relaxed) / status.reads : 0;
+        status.read_p99_ns = device->reads.percentile(0.99);
+        status.write_avg_ns = status.writes > 0 ? device->writes.total_ns.load(std::memory_order_relaxed) / status.writes : 0;
+        status.write_p99_ns = device->writes.percentile(0.99);
+        report.push_back(status);
+    }
+    return report;
+}
+
+// Función para medir la fragmentación de la Swap: bloques libres y segmentos contiguos
+SwapFragmentation getSwapFragmentation()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    SwapFragmentation stats;
+    json jsonRAM;
+    json jsonSwap;
+    if (!loadMemorySnapshot(jsonRAM, jsonSwap))
+    {
+        return stats;
+    }
+
+    int run = 0;
+    for (const auto &frame : jsonSwap["frames"])
+    {
+        stats.total_slots++;
+        if (frame["is_free"])
+        {
+            stats.free_slots++;
+            if (run == 0)
+            {
+                stats.free_extents++;
+            }
+            run++;
+            stats.largest_free_extent = std::max(stats.largest_free_extent, run);
+        }
+        else
+        {
+            run = 0;
+        }
+    }
+    if (stats.free_slots > 0)
+    {
+        stats.external_fragmentation = 1.0 - static_cast<double>(stats.largest_free_extent) / stats.free_slots;
+    }
+
+    // Los segmentos compartidos se cuentan una sola vez, no en cada proceso que los usa
+    for (const json *process : pageTables(jsonRAM))
+    {
+        for (const auto &segmentos : (*process)["segments"])
+        {
+            if (segmentos.contains("shared_id"))
+            {
+                continue;
+            }
+            bool contiguous = true;
+            int previous = -1;
+            for (const auto &paginas : segmentos["pages"])
+            {
+                int slot = paginas["frame_swap"];
+                if (slot < 0)
+                {
+                    continue; // Página perezosa todavía sin materializar
+                }
+                if (previous >= 0 && slot != previous + 1)
+                {
+                    contiguous = false;
+                }
+                previous = slot;
+            }
+            stats.segments++;
+            if (contiguous)
+            {
+                stats.contiguous_segments++;
+            }
+        }
+    }
+    return stats;
+}
+
+// Función para armar el reporte de memoria de todos los procesos. Agrupa los frames de
+// RAM y Swap por process_id en una sola pasada y después suma a cada proceso los frames
+// de los segmentos compartidos que usa: O(frames + segmentos), no O(frames × procesos).
+std::vector<ProcessMemoryUsage> getProcessMemoryReport()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    std::vector<ProcessMemoryUsage> report;
+    json jsonRAM;
+    json jsonSwap;
+    if (!loadMemorySnapshot(jsonRAM, jsonSwap))
+    {
+        return report;
+    }
+
+    std::map<int, std::pair<int, int>> framesByOwner; // process_id -> (RAM, Swap)
+    for (const auto &frame : jsonRAM["frames"])
+    {
+        if (!frame["is_free"])
+        {
+            framesByOwner[frame["process_id"]].first++;
+        }
+    }
+    for (const auto &frame : jsonSwap["frames"])
+    {
+        if (!frame["is_free"])
+        {
+            framesByOwner[frame["process_id"]].second++;
+        }
+    }
+
+    std::map<int, int> sharedRefcount;
+    if (jsonRAM.contains("shared_segments"))
+    {
+        for (const auto &shared : jsonRAM["shared_segments"])
+        {
+            sharedRefcount[shared["process_id"]] = std::max(shared["refcount"].get<int>(), 1);
+        }
+    }
+
+    double frameKB = MemoryCalculator::frameSize() / 1024.0;
+    for (const auto &process : jsonRAM["SO"])
+    {
+        ProcessMemoryUsage usage;
+        usage.process_id = process["process_id"];
+        usage.suspended = process.value("suspended", false);
+        auto owned = framesByOwner.find(usage.process_id);
+        if (owned != framesByOwner.end())
+        {
+            usage.ram_frames = owned->second.first;
+            usage.swap_frames = owned->second.second;
+        }
+        usage.proportional_kb = usage.ram_frames * frameKB;
+
+        for (const auto &segmentos : process["segments"])
+        {
+            if (!segmentos.contains("shared_id"))
+            {
+                continue;
+            }
+            int shared_id = segmentos["shared_id"];
+            auto shared = framesByOwner.find(shared_id);
+            if (shared != framesByOwner.end())
+            {
+                usage.shared_ram_frames += shared->second.first;
+                usage.shared_swap_frames += shared->second.second;
+                usage.proportional_kb += shared->second.first * frameKB / sharedRefcount[shared_id];
+            }
+        }
+        report.push_back(usage);
+    }
+
+    std::sort(report.begin(), report.end(), [](const ProcessMemoryUsage &a, const ProcessMemoryUsage &b)
+              {
+                  if (a.proportional_kb != b.proportional_kb)
+                  {
+                      return a.proportional_kb > b.proportional_kb;
+                  }
+                  if (a.swap_frames + a.shared_swap_frames != b.swap_frames + b.shared_swap_frames)
+                  {
+                      return a.swap_frames + a.shared_swap_frames > b.swap_frames + b.shared_swap_frames;
+                  }
+                  return a.process_id < b.process_id;
+              });
+    return report;
+}
+
+// Función para listar los segmentos compartidos con sus referencias
+std::vector<SharedSegmentInfo> getSharedSegments()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    std::vector<SharedSegmentInfo> segments;
+    json jsonRAM;
+    json jsonSwap;
+    if (!loadMemorySnapshot(jsonRAM, jsonSwap) || !jsonRAM.contains("shared_segments"))
+    {
+        return segments;
+    }
+
+    for (const auto &shared : jsonRAM["shared_segments"])
+    {
+        SharedSegmentInfo info;
+        info.shared_id = shared["process_id"];
+        info.segment_id = shared["segments"][0]["segment_id"];
+        info.refcount = shared["refcount"];
+        info.pages = static_cast<int>(shared["segments"][0]["pages"].size());
+        info.resident_pages = static_cast<int>(shared["ram_frames"].size());
+        segments.push_back(info);
+    }
+    return segments;
+}
+
+bool updateTable(int segmento, int pagina, int process_id, int new_page_ram_frame)
+{
+    OperationTimer timer(MemoryOperation::UpdateTable);
+    MemoryLock lock;
+    json jsonData;
+    json jsonSwap;
+    if (!loadMemoryJson(jsonData, jsonSwap))
+    {
+        return false;
+    }
+
+    // Las páginas de un segmento compartido están en la tabla del segmento compartido
+    json *process = findProcessEntry(jsonData, process_id);
+    json *owner = process ? findSegmentOwner(jsonData, *process, segmento) : nullptr;
+    json *paginas = owner ? findPageEntry(*owner, segmento, pagina) : nullptr;
+    if (paginas != nullptr)
+    {
+        (*paginas)["frame_ram"] = new_page_ram_frame;
+        (*paginas)["presence_bit"] = 1;
+    }
+
+    // Guarda el archivo JSON con los cambios
+    return saveMemoryJson(jsonData, jsonSwap, false);
+}
+
+// Función para contar las páginas residentes de un proceso y su working set: las páginas
+// referenciadas en las últimas window referencias del proceso. Las páginas de segmentos
+// compartidos están en la tabla del segmento compartido y no se cuentan.
+static void countWorkingSet(const json &process, int window, int &resident, int &workingSet)
+{
+    long vtime = process.value("vtime", 0L);
+    resident = 0;
+    workingSet = 0;
+    for (const auto &segmentos : process["segments"])
+    {
+        for (const auto &paginas : segmentos["pages"])
+        {
+            if (paginas["presence_bit"] == 1)
+            {
+                resident++;
+            }
+            if (paginas.contains("last_reference") && vtime - paginas["last_reference"].get<long>() < window)
+            {
+                workingSet++;
+            }
+        }
+    }
+}
+
+// Función para desalojar la página residente menos usada recientemente de un proceso. Con
+// onlyOutside solo sale si está fuera del working set. Devuelve false si no desalojó nada.
+static bool evictLeastRecent(json &jsonRAM, json &process, bool onlyOutside)
+{
+    long vtime = process.value("vtime", 0L);
+    json *victim = nullptr;
+    long oldest = 0;
+    for (auto &segmentos : process["segments"])
+    {
+        for (auto &paginas : segmentos["pages"])
+        {
+            long last = paginas.value("last_reference", 0L);
+            if (paginas["presence_bit"] == 1 && (victim == nullptr || last < oldest))
+            {
+                victim = &paginas;
+                oldest = last;
+            }
+        }
+    }
+    if (victim == nullptr || (onlyOutside && vtime - oldest < pffConfig.window))
+    {
+        return false;
+    }
+    evictPage(jsonRAM, process, *victim);
+    return true;
+}
+
+// Función para ajustar en cada fallo el presupuesto de frames del proceso según el tiempo
+// desde su fallo anterior (PFF) y hacer lugar para la página que entra. Si los fallos son
+// seguidos el presupuesto crece; si son espaciados se achica y salen las páginas que
+// quedaron fuera del working set, así sus frames pasan a otros procesos.
+static void applyFaultFrequency(json &jsonRAM, json &process)
+{
+    long vtime = process.value("vtime", 0L);
+    long interval = vtime - process.value("last_fault", 0L);
+    process["last_fault"] = vtime;
+
+    int resident = 0;
+    int workingSet = 0;
+    countWorkingSet(process, pffConfig.window, resident, workingSet);
+    int budget = process.value("frame_budget", std::max(resident, 1));
+    if (interval <= pffConfig.grow_interval)
+    {
+        budget++;
+    }
+    else if (interval >= pffConfig.shrink_interval)
+    {
+        budget--;
+        while (evictLeastRecent(jsonRAM, process, true))
+        {
+            resident--;
+        }
+    }
+    budget = std::max(pffConfig.min_frames, std::min(budget, pffConfig.max_frames));
+    process["frame_budget"] = budget;
+
+    // Sin lugar en el presupuesto la página nueva reemplaza a la menos usada del proceso
+    while (resident >= budget && evictLeastRecent(jsonRAM, process, false))
+    {
+        resident--;
+    }
+}
+
+// Función para dar a una página perezosa su slot de Swap, con el contenido sacado de la
+// imagen del programa. Se prefiere el slot siguiente al de la página anterior del
+// segmento, para que el segmento vaya quedando contiguo.
+static bool materializePage(json &jsonSwap, json &process, json &page, int segmento, int pagina)
+{
+    const json *source = nullptr;
+    int previousSlot = -1;
+    for (const auto &segmentos : process["segments"])
+    {
+        if (segmentos["segment_id"] == segmento && segmentos.contains("source"))
+        {
+            source = &segmentos["source"];
+            for (const auto &paginas : segmentos["pages"])
+            {
+                if (paginas["page_number"] == pagina - 1)
+                {
+                    previousSlot = paginas["frame_swap"];
+                }
+            }
+        }
+    }
+    if (source == nullptr)
+    {
+        std::cerr << "La página " << pagina << " del segmento " << segmento << " no tiene programa de origen" << std::endl;
+        return false;
+    }
+
+    ProgramImage image;
+    uint64_t hash = 0;
+    const string programPath = (*source)["program"];
+    if (!loadProgram(programPath, image, &hash))
+    {
+        return false;
+    }
+    if (programSource(programPath, hash)["hash"] != (*source)["hash"])
+    {
+        std::cerr << "El programa " << programPath << " cambió desde que se cargó el proceso" << std::endl;
+        return false;
+    }
+    if (segmento < 1 || static_cast<size_t>(segmento) > image->size() ||
+        pagina < 1 || static_cast<size_t>(pagina) > (*image)[segmento - 1].size())
+    {
+        std::cerr << "La página no existe en el programa " << programPath << std::endl;
+        return false;
+    }
+
+    auto &swapFrames = jsonSwap["frames"];
+    std::vector<int> slots;
+    if (!allocateSwapSlots(swapFrames, 1, slots, previousSlot >= 0 ? previousSlot + 1 : -1))
+    {
+        std::cerr << "Memoria Swap Insuficiente" << std::endl;
+        return false;
+    }
+    int slot = slots[0];
+
+    auto &frame = swapFrames[slot];
+    frame["segment_id"] = segmento;
+    frame["page_number"] = pagina;
+    if (!stageSwapWrite(slot, (*image)[segmento - 1][pagina - 1]))
+    {
+        return false;
+    }
+    frame["process_id"] = process["process_id"];
+    frame["is_free"] = false;
+    if (process.contains("swap_frames"))
+    {
+        process["swap_frames"].push_back(slot);
+    }
+    page["frame_swap"] = slot;
+    pagesMaterialized++;
+    memoryTrace.record(MemoryEventType::Materialize, process["process_id"], segmento, pagina, -1, slot);
+    return true;
+}
+
+// Función para leer de Swap la página que tuvo un fallo. Las páginas siguientes del segmento
+// que están en los slots siguientes y fuera de RAM (hasta completar un cluster) se leen con
+// la misma lectura y quedan en swapReadahead: el próximo fallo secuencial no lee Swap.
+static bool readFaultedPage(const json &segmentPages, int pagina, int slot, std::string &content)
+{
+    if (sharedTable.isOpen() && sharedTable.getHeader()->sequence.load(std::memory_order_relaxed) != readaheadSequence)
+    {
+        // Otro proceso guardó cambios: los slots leídos por adelantado pueden haber cambiado
+        swapReadahead.clear();
+        readaheadSequence = sharedTable.getHeader()->sequence.load(std::memory_order_relaxed);
+    }
+
+    auto cached = swapReadahead.find(slot);
+    if (cached != swapReadahead.end())
+    {
+        content = std::move(cached->second);
+        swapReadahead.erase(cached);
+        readaheadHits++;
+        return true;
+    }
+
+    int count = 1;
+    if (stagedSwapContent(slot) == nullptr)
+    {
+        for (size_t i = static_cast<size_t>(pagina); i < segmentPages.size() && count < SWAP_CLUSTER_SIZE; ++i)
+        {
+            const json &next = segmentPages[i];
+            if (next["page_number"] != pagina + count || next["frame_swap"] != slot + count ||
+                next["presence_bit"] == 1 || stagedSwapContent(slot + count) != nullptr)
+            {
+                break;
+            }
+            count++;
+        }
+    }
+    if (count == 1)
+    {
+        return readSwapSlot(slot, content);
+    }
+
+    std::vector<std::string> contents;
+    readSwapRange(slot, count, contents);
+    if (contents.empty())
+    {
+        return false;
+    }
+    content = std::move(contents[0]);
+    swapReadahead.clear();
+    for (size_t i = 1; i < contents.size(); ++i)
+    {
+        swapReadahead[slot + static_cast<int>(i)] = std::move(contents[i]);
+    }
+    readaheadPages += contents.size() - 1;
+    return true;
+}
+
+// Función para traer una página a RAM sobre los JSON ya cargados. swapChanged indica
+// si una página perezosa recibió su slot de Swap.
+static bool faultInPage(json &jsonRAM, json &jsonSwap, json &process, json &page,
+                        int segmento, int pagina, int process_id, bool &swapChanged)
+{
+    // La página ya está en RAM, no hay nada que traer
+    if (page["presence_bit"] == 1)
+    {
+        return true;
+    }
+
+    memoryTrace.record(MemoryEventType::PageFault, process_id, segmento, pagina, -1, page["frame_swap"]);
+
+    // Primer acceso a una página perezosa: recibe su lugar en Swap con el contenido del programa
+    if (page["frame_swap"] == -1)
+    {
+        if (!materializePage(jsonSwap, process, page, segmento, pagina))
+        {
+            return false;
+        }
+        swapChanged = true;
+    }
+
+    if (pffConfig.enabled && process_id > 0)
+    {
+        applyFaultFrequency(jsonRAM, process);
+    }
+    else
+    {
+        // Reemplazo local: la página residente del segmento sale de RAM
+        for (auto &segmentos : process["segments"])
+        {
+            if (segmentos["segment_id"] == segmento)
+            {
+                for (auto &paginas : segmentos["pages"])
+                {
+                    if (paginas["presence_bit"] == 1)
+                    {
+                        evictPage(jsonRAM, process, paginas);
+                    }
+                }
+            }
+        }
+    }
+
+    // Si el segmento no tenía página residente (el reclaimer la desalojó) se necesita un
+    // frame libre; si no queda ninguno hay que desalojar de forma síncrona
+    int new_ram_frame_assigned = takeFreeFrame(jsonRAM["frames"]);
+    if (new_ram_frame_assigned < 0)
+    {
+        reclaimStats.stalls++;
+        reclaimFrames(jsonRAM, 1);
+        new_ram_frame_assigned = takeFreeFrame(jsonRAM["frames"]);
+    }
+    if (new_ram_frame_assigned < 0)
+    {
+        std::cerr << "Memoria RAM Insuficiente" << std::endl;
+        return false;
+    }
+
+    int frame_number_swap = page["frame_swap"];
+    auto &frame = jsonRAM["frames"][new_ram_frame_assigned];
+    frame["is_free"] = false;
+    frame["segment_id"] = segmento;
+    frame["page_number"] = pagina;
+    frame["process_id"] = process_id;
+    static const json noPages = json::array();
+    const json *segmentPages = &noPages;
+    for (const auto &segmentos : process["segments"])
+    {
+        if (segmentos["segment_id"] == segmento)
+        {
+            segmentPages = &segmentos["pages"];
+        }
+    }
+    std::string content;
+    if (!readFaultedPage(*segmentPages, pagina, frame_number_swap, content))
+    {
+        return false;
+    }
+    frame["content"] = std::move(content);
+    pageFaults++;
+    process["faults"] = process.value("faults", 0L) + 1;
+    memoryTrace.record(MemoryEventType::SwapIn, process_id, segmento, pagina, new_ram_frame_assigned, frame_number_swap);
+    bytesSwappedIn += frame["content"].get_ref<const std::string &>().size();
+
+    page["frame_ram"] = new_ram_frame_assigned;
+    page["swap_hash"] = hashText(frame["content"].get_ref<const std::string &>());
+    page["presence_bit"] = 1;
+    page["referenced_bit"] = 1;
+    page["dirty_bit"] = 0;
+    if (process.contains("ram_frames"))
+    {
+        process["ram_frames"].push_back(new_ram_frame_assigned);
+    }
+    return true;
+}
+
+// Función para suspender el proceso activo de menor prioridad (a igual prioridad, el de
+// más fallos por referencia) y sacar de RAM todas sus páginas. Siempre queda al menos
+// un proceso activo. Devuelve false si no había a quién suspender.
+static bool suspendLowestPriority(json &jsonRAM)
+{
+    json *victim = nullptr;
+    int active = 0;
+    for (auto &process : jsonRAM["SO"])
+    {
+        if (process.value("suspended", false))
+        {
+            continue;
+        }
+        active++;
+        if (victim == nullptr)
+        {
+            victim = &process;
+            continue;
+        }
+        int priority = process.value("priority", 0);
+        int victimPriority = victim->value("priority", 0);
+        double faultRate = process.value("faults", 0L) / std::max(1.0, process.value("vtime", 0.0));
+        double victimFaultRate = victim->value("faults", 0L) / std::max(1.0, victim->value("vtime", 0.0));
+        if (priority < victimPriority || (priority == victimPriority && faultRate > victimFaultRate))
+        {
+            victim = &process;
+        }
+    }
+    if (victim == nullptr || active < 2)
+    {
+        return false;
+    }
+
+    for (auto &segmentos : (*victim)["segments"])
+    {
+        for (auto &paginas : segmentos["pages"])
+        {
+            if (paginas["presence_bit"] == 1)
+            {
+                evictPage(jsonRAM, *victim, paginas);
+            }
+        }
+    }
+    (*victim)["suspended"] = true;
+    thrashingStats.suspensions++;
+    std::cout << "Thrashing: proceso " << (*victim)["process_id"] << " suspendido" << std::endl;
+    return true;
+}
+
+// Función para reanudar el proceso suspendido de mayor prioridad; sus páginas vuelven a
+// RAM a medida que las usa
+static bool resumeHighestPriority(json &jsonRAM)
+{
+    json *chosen = nullptr;
+    for (auto &process : jsonRAM["SO"])
+    {
+        if (process.value("suspended", false) &&
+            (chosen == nullptr || process.value("priority", 0) > chosen->value("priority", 0)))
+        {
+            chosen = &process;
+        }
+    }
+    if (chosen == nullptr)
+    {
+        return false;
+    }
+    (*chosen)["suspended"] = false;
+    thrashingStats.resumes++;
+    std::cout << "Control de carga: proceso " << (*chosen)["process_id"] << " reanudado" << std::endl;
+    return true;
+}
+
+// Función para registrar una referencia en la ventana del detector de thrashing. Un
+// episodio empieza cuando la proporción de fallos llega a thrash_ratio y termina cuando
+// baja de calm_ratio. Con el control de carga activo se suspende o reanuda a lo sumo un
+// proceso por ventana, para ver el efecto antes de volver a actuar.
+static void recordReference(json &jsonRAM, bool fault)
+{
+    size_t window = static_cast<size_t>(std::max(loadControlConfig.window, 1));
+    if (faultWindow.size() != window)
+    {
+        faultWindow.assign(window, 0);
+        faultWindowNext = 0;
+        faultWindowFilled = 0;
+        faultWindowFaults = 0;
+    }
+    faultWindowFaults += (fault ? 1 : 0) - faultWindow[faultWindowNext];
+    faultWindow[faultWindowNext] = fault ? 1 : 0;
+    faultWindowNext = (faultWindowNext + 1) % window;
+    faultWindowFilled = std::min(faultWindowFilled + 1, window);
+    referencesSinceAction++;
+    if (faultWindowFilled < window)
+    {
+        return;
+    }
+
+    double ratio = static_cast<double>(faultWindowFaults) / window;
+    thrashingStats.fault_ratio = ratio;
+    auto now = std::chrono::steady_clock::now();
+    if (!thrashingStats.thrashing && ratio >= loadControlConfig.thrash_ratio)
+    {
+        thrashingStats.thrashing = true;
+        thrashingStats.episodes++;
+        thrashingStart = now;
+        std::cout << "Thrashing detectado: " << faultWindowFaults << " fallos en " << window << " referencias" << std::endl;
+    }
+    else if (thrashingStats.thrashing && ratio < loadControlConfig.calm_ratio)
+    {
+        double seconds = std::chrono::duration<double>(now - thrashingStart).count();
+        thrashingStats.thrashing = false;
+        thrashingStats.total_seconds += seconds;
+        thrashingStats.longest_seconds = std::max(thrashingStats.longest_seconds, seconds);
+        std::cout << "Fin del thrashing tras " << seconds << " s" << std::endl;
+    }
+
+    if (!loadControlConfig.enabled || referencesSinceAction < static_cast<long>(window))
+    {
+        return;
+    }
+    if (thrashingStats.thrashing)
+    {
+        if (suspendLowestPriority(jsonRAM))
+        {
+            referencesSinceAction = 0;
+        }
+    }
+    else if (ratio < loadControlConfig.calm_ratio && resumeHighestPriority(jsonRAM))
+    {
+        referencesSinceAction = 0;
+    }
+}
+
+// Función para acceder a una página de un proceso: la trae a RAM si hace falta, marca el
+// bit de referencia y, si se escribe, reemplaza el contenido y marca el bit de modificado.
+static bool accessPage(int segmento, int pagina, int process_id, const std::string *data, std::string *content,
+                       MemoryOperation operation)
+{
+    OperationTimer timer(operation);
+    MemoryLock lock;
+
+    json jsonRAM;
+    json jsonSwap;
+    if (!loadMemoryJson(jsonRAM, jsonSwap))
+    {
+        return false;
+    }
+
+    json *process = findProcessEntry(jsonRAM, process_id);
+    json *owner = process ? findSegmentOwner(jsonRAM, *process, segmento) : nullptr;
+    json *page = owner ? findPageEntry(*owner, segmento, pagina) : nullptr;
+    if (page == nullptr)
+    {
+        std::cerr << "Página no encontrada: segmento " << segmento << ", página " << pagina
+                  << ", process_id " << process_id << std::endl;
+        return false;
+    }
+    if (process->value("suspended", false))
+    {
+        std::cerr << "El proceso " << process_id << " está suspendido por el control de carga" << std::endl;
+        return false;
+    }
+    if (data != nullptr && isReadOnlySegment(*process, segmento))
+    {
+        std::cerr << "El segmento " << segmento << " es de solo lectura" << std::endl;
+        return false;
+    }
+
+    // Reloj virtual de referencias del proceso para el working set; las páginas compartidas
+    // usan el reloj del segmento compartido
+    long vtime = process->value("vtime", 0L) + 1;
+    (*process)["vtime"] = vtime;
+    if (owner != process)
+    {
+        vtime = owner->value("vtime", 0L) + 1;
+        (*owner)["vtime"] = vtime;
+    }
+
+    // Las páginas compartidas se cargan a nombre del segmento compartido
+    bool swapChanged = false;
+    bool present = (*page)["presence_bit"] == 1;
+    if (!faultInPage(jsonRAM, jsonSwap, *owner, *page, segmento, pagina, (*owner)["process_id"], swapChanged))
+    {
+        return false;
+    }
+
+    auto &frame = jsonRAM["frames"][(*page)["frame_ram"].get<int>()];
+    (*page)["referenced_bit"] = 1;
+    (*page)["last_reference"] = vtime;
+    if (!present)
+    {
+        timer.bytes += frame["content"].get_ref<const std::string &>().size();
+    }
+    if (data != nullptr)
+    {
+        // Escribir el mismo contenido no ensucia la página: su copia de Swap sigue vigente
+        std::string newContent = data->substr(0, pageSize);
+        if (frame["content"] == newContent)
+        {
+            writebackStats.unchanged_writes++;
+        }
+        else
+        {
+            frame["content"] = newContent;
+            (*page)["dirty_bit"] = 1;
+        }
+        timer.bytes += newContent.size();
+    }
+    if (content != nullptr)
+    {
+        *content = frame["content"];
+    }
+
+    // Después del acceso, porque el control de carga puede suspender a este mismo proceso
+    recordReference(jsonRAM, !present);
+
+    // Guarda el archivo JSON con los cambios; Swap.json solo si una página perezosa recibió su slot
+    if (!saveMemoryJson(jsonRAM, jsonSwap, swapChanged))
+    {
+        return false;
+    }
+
+    wakeReclaimerIfLow(jsonRAM["frames"]);
+    return true;
+}
+
+bool memorySwap(int segmento, int pagina, int process_id)
+{
+    return accessPage(segmento, pagina, process_id, nullptr, nullptr, MemoryOperation::Swap);
+}
+
+bool memoryRead(int segmento, int pagina, int process_id, std::string &content)
+{
+    return accessPage(segmento, pagina, process_id, nullptr, &content, MemoryOperation::Read);
+}
+
+VirtualAddress translateAddress(uint64_t address)
+{
+    return DefaultGeometry::split(address);
+}
+
+// Función para leer desde una dirección virtual hasta el final de su página
+bool memoryReadAddress(int process_id, uint64_t address, std::string &content)
+{
+    if (!DefaultGeometry::valid(address))
+    {
+        std::cerr << "Dirección fuera de las páginas del segmento: " << address << std::endl;
+        return false;
+    }
+
+    VirtualAddress parts = DefaultGeometry::split(address);
+    std::string page;
+    if (!memoryRead(static_cast<int>(parts.segment), static_cast<int>(parts.page) + 1, process_id, page))
+    {
+        return false;
+    }
+    content = parts.offset < page.size() ? page.substr(parts.offset) : "";
+    return true;
+}
+
+bool memoryWrite(int segmento, int pagina, int process_id, const std::string &data)
+{
+    return accessPage(segmento, pagina, process_id, &data, nullptr, MemoryOperation::Write);
+}
+
+// Función para obtener los contadores de escritura y el estado de la caché de Swap
+WritebackStats getWritebackStats()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    WritebackStats stats = writebackStats;
+    json jsonRAM;
+    json jsonSwap;
+    if (!loadMemorySnapshot(jsonRAM, jsonSwap))
+    {
+        return stats;
+    }
+
+    for (const json *process : pageTables(jsonRAM))
+    {
+        for (const auto &segmentos : (*process)["segments"])
+        {
+            for (const auto &paginas : segmentos["pages"])
+            {
+                if (paginas["presence_bit"] == 1)
+                {
+                    (paginas.value("dirty_bit", 0) == 1 ? stats.dirty_pages : stats.cached_pages)++;
+                }
+            }
+        }
+    }
+    return stats;
+}
+
+MemoryStats getMemoryStats()
+{
+    MemoryStats stats;
+    for (int i = 0; i < OPERATION_COUNT; ++i)
+    {
+        const LatencyHistogram &histogram = operationLatency[i];
+        OperationStats operation;
+        operation.name = operationNames[i];
+        operation.count = histogram.count.load(std::memory_order_relaxed);
+        operation.bytes = histogram.bytes.load(std::memory_order_relaxed);
+        operation.total_ns = histogram.total_ns.load(std::memory_order_relaxed);
+        operation.max_ns = histogram.max_ns.load(std::memory_order_relaxed);
+        operation.p50_ns = histogram.percentile(0.50);
+        operation.p90_ns = histogram.percentile(0.90);
+        operation.p99_ns = histogram.percentile(0.99);
+        stats.operations.push_back(operation);
+    }
+    stats.page_faults = pageFaults.load(std::memory_order_relaxed);
+    stats.evictions = evictions.load(std::memory_order_relaxed);
+    stats.bytes_swapped_in = bytesSwappedIn.load(std::memory_order_relaxed);
+    stats.bytes_written_back = bytesWrittenBack.load(std::memory_order_relaxed);
+    stats.readahead_pages = readaheadPages.load(std::memory_order_relaxed);
+    stats.readahead_hits = readaheadHits.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void resetMemoryStats()
+{
+    for (auto &histogram : operationLatency)
+    {
+        histogram.reset();
+    }
+    pageFaults = 0;
+    evictions = 0;
+    bytesSwappedIn = 0;
+    bytesWrittenBack = 0;
+    readaheadPages = 0;
+    readaheadHits = 0;
+}
+
+// Función para guardar las estadísticas en JSON, con las cubetas no vacías de cada
+// histograma como pares [límite inferior en ns, cantidad]
+bool exportMemoryStats(const std::string &path)
+{
+    MemoryStats stats = getMemoryStats();
+    json document;
+    document["page_faults"] = stats.page_faults;
+    document["evictions"] = stats.evictions;
+    document["bytes_swapped_in"] = stats.bytes_swapped_in;
+    document["bytes_written_back"] = stats.bytes_written_back;
+    document["readahead_pages"] = stats.readahead_pages;
+    document["readahead_hits"] = stats.readahead_hits;
+    document["operations"] = json::array();
+    for (int i = 0; i < OPERATION_COUNT; ++i)
+    {
+        const OperationStats &operation = stats.operations[i];
+        json entry;
+        entry["name"] = operation.name;
+        entry["count"] = operation.count;
+        entry["bytes"] = operation.bytes;
+        entry["total_ns"] = operation.total_ns;
+        entry["max_ns"] = operation.max_ns;
+        entry["p50_ns"] = operation.p50_ns;
+        entry["p90_ns"] = operation.p90_ns;
+        entry["p99_ns"] = operation.p99_ns;
+        entry["histogram"] = json::array();
+        for (int bucket = 0; bucket < LATENCY_BUCKETS; ++bucket)
+        {
+            uint64_t count = operationLatency[i].buckets[bucket].load(std::memory_order_relaxed);
+            if (count > 0)
+            {
+                entry["histogram"].push_back({latencyBucketValue(bucket), count});
+            }
+        }
+        document["operations"].push_back(entry);
+    }
+
+    ofstream output(path);
+    if (!output.is_open())
+    {
+        std::cerr << "No se pudo abrir el archivo: " << path << std::endl;
+        return false;
+    }
+    output << document.dump(4);
+    return true;
+}
+
+// Función para ajustar las marcas de agua de frames libres del reclaimer
+void setReclaimWatermarks(int low, int high)
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    reclaimStats.low_watermark = low;
+    reclaimStats.high_watermark = high < low ? low : high;
+}
+
+ReclaimStats getReclaimStats()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    return reclaimStats;
+}
+
+void setPFFConfig(const PFFConfig &config)
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    pffConfig = config;
+    pffConfig.min_frames = std::max(pffConfig.min_frames, 1);
+    pffConfig.max_frames = std::max(pffConfig.max_frames, pffConfig.min_frames);
+}
+
+PFFConfig getPFFConfig()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    return pffConfig;
+}
+
+void setLoadControlConfig(const LoadControlConfig &config)
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    loadControlConfig = config;
+    loadControlConfig.window = std::max(loadControlConfig.window, 1);
+}
+
+LoadControlConfig getLoadControlConfig()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    return loadControlConfig;
+}
+
+ThrashingStats getThrashingStats()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    ThrashingStats stats = thrashingStats;
+    if (stats.thrashing)
+    {
+        stats.current_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - thrashingStart).count();
+        stats.total_seconds += stats.current_seconds;
+        stats.longest_seconds = std::max(stats.longest_seconds, stats.current_seconds);
+    }
+
+    json jsonRAM;
+    json jsonSwap;
+    if (loadMemorySnapshot(jsonRAM, jsonSwap))
+    {
+        for (const auto &process : jsonRAM["SO"])
+        {
+            if (process.value("suspended", false))
+            {
+                stats.suspended.push_back(process["process_id"]);
+            }
+        }
+    }
+    return stats;
+}
+
+// Función para cambiar un campo de la tabla de un proceso y guardarla
+static bool setProcessField(int process_id, const char *field, const json &value)
+{
+    MemoryLock lock;
+    json jsonRAM;
+    json jsonSwap;
+    if (!loadMemoryJson(jsonRAM, jsonSwap))
+    {
+        return false;
+    }
+
+    json *process = findProcessEntry(jsonRAM, process_id);
+    if (process == nullptr || process_id < 0)
+    {
+        std::cerr << "Proceso no encontrado: " << process_id << std::endl;
+        return false;
+    }
+    (*process)[field] = value;
+    return saveMemoryJson(jsonRAM, jsonSwap, false);
+}
+
+OomStats getOomStats()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    return oomStats;
+}
+
+std::vector<OomCandidateInfo> getOomRanking()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    std::vector<OomCandidateInfo> ranking;
+    json jsonRAM;
+    json jsonSwap;
+    if (!loadMemorySnapshot(jsonRAM, jsonSwap))
+    {
+        return ranking;
+    }
+
+    std::vector<OomCandidate> heap = oomCandidates(jsonRAM, {});
+    OomCandidate victim;
+    while (popOomVictim(heap, victim))
+    {
+        ranking.push_back({victim.process_id, victim.priority, victim.ram_frames, victim.swap_frames});
+    }
+    return ranking;
+}
+
+bool setMemoryPriority(int process_id, int priority)
+{
+    return setProcessField(process_id, "priority", priority);
+}
+
+bool resumeProcessMemory(int process_id)
+{
+    return setProcessField(process_id, "suspended", false);
+}
+
+bool startMemoryTrace(const std::string &path, int capacity)
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    return memoryTrace.start(path, static_cast<size_t>(std::max(capacity, 1)));
+}
+
+void stopMemoryTrace()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    memoryTrace.stop();
+}
+
+MemoryTraceStatus getMemoryTraceStatus()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    MemoryTraceStatus status;
+    status.active = memoryTrace.active();
+    status.path = memoryTrace.path();
+    status.recorded = memoryTrace.recorded();
+    status.written = memoryTrace.written();
+    status.dropped = memoryTrace.dropped();
+    return status;
+}
+
+// Función para obtener el working set y el presupuesto de frames de cada proceso
+std::vector<WorkingSetInfo> getWorkingSets()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    std::vector<WorkingSetInfo> sets;
+    json jsonRAM;
+    json jsonSwap;
+    if (!loadMemorySnapshot(jsonRAM, jsonSwap))
+    {
+        return sets;
+    }
+
+    for (const auto &process : jsonRAM["SO"])
+    {
+        WorkingSetInfo info;
+        info.process_id = process["process_id"];
+        countWorkingSet(process, pffConfig.window, info.resident_pages, info.working_set);
+        info.frame_budget = process.value("frame_budget", info.resident_pages);
+        info.references = process.value("vtime", 0L);
+        info.faults = process.value("faults", 0L);
+        sets.push_back(info);
+    }
+    return sets;
+}
+
+// Hilo del reclaimer: despierta periódicamente o cuando un fallo de página deja la RAM
+// por debajo de la marca baja, y desaloja páginas hasta alcanzar la marca alta
+static void reclaimerLoop()
+{
+    std::unique_lock<std::mutex> wakeLock(reclaimer.wakeMutex);
+    while (!reclaimer.stop)
+    {
+        reclaimer.wakeup.wait_for(wakeLock, std::chrono::seconds(1));
+        if (reclaimer.stop)
+        {
+            break;
+        }
+
+        wakeLock.unlock();
+        {
+            MemoryLock lock;
+            json jsonRAM;
+            json jsonSwap;
+            if (loadMemoryJson(jsonRAM, jsonSwap) &&
+                countFreeFrames(jsonRAM["frames"]) < reclaimStats.low_watermark &&
+                reclaimFrames(jsonRAM, reclaimStats.high_watermark) > 0)
+            {
+                saveMemoryJson(jsonRAM, jsonSwap, false);
+            }
+        }
+        wakeLock.lock();
+    }
+}
+
+void startReclaimer()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    if (reclaimStats.running)
+    {
+        return;
+    }
+    reclaimer.stop = false;
+    reclaimer.worker = std::thread(reclaimerLoop);
+    reclaimStats.running = true;
+}
+
+void stopReclaimer()
+{
+    {
+        std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+        if (!reclaimStats.running)
+        {
+            return;
+        }
+        reclaimStats.running = false;
+    }
+    {
+        std::lock_guard<std::mutex> wakeLock(reclaimer.wakeMutex);
+        reclaimer.stop = true;
+    }
+    reclaimer.wakeup.notify_one();
+    reclaimer.worker.join();
+}
+
+ZeroPoolStats getZeroPoolStats()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    ZeroPoolStats stats = zeroPoolStats;
+    json jsonRAM;
+    json jsonSwap;
+    if (loadMemorySnapshot(jsonRAM, jsonSwap))
+    {
+        for (const auto &frame : jsonRAM["frames"])
+        {
+            if (frame["is_free"])
+            {
+                stats.ready_frames++;
+            }
+        }
+    }
+    return stats;
+}
+
+// Función para abrir el segmento de memoria compartida con el tamaño que corresponde a los JSON
+static bool openSharedTable(const std::string &name, const json &jsonRAM, const json &jsonSwap, bool &created)
+{
+    uint32_t ramFrames = static_cast<uint32_t>(jsonRAM["frames"].size());
+    uint32_t swapFrames = static_cast<uint32_t>(jsonSwap["frames"].size());
+    // Espacio para las tablas de páginas: una base fija más un margen por slot de Swap (cada
+    // página cargada tiene un slot y su entrada ocupa unos 130 bytes), y al menos 4 veces las
+    // tablas actuales, porque las páginas perezosas tienen entrada sin tener slot
+    size_t currentTables = json::to_msgpack(json{{"ram", withoutFrames(jsonRAM)}, {"swap", withoutFrames(jsonSwap)}}).size();
+    uint32_t tablesCapacity = static_cast<uint32_t>(std::max<size_t>(64 * 1024 + 512 * swapFrames, 4 * currentTables));
+
+    return sharedTable.open(name, ramFrames, swapFrames, tablesCapacity, created);
+}
+
+// Función para conectarse a la memoria compartida. El primer proceso la crea con el
+// contenido de RAM.json y Swap.json; desde entonces todas las operaciones usan el
+// segmento y no los archivos. Si el segmento abierto lo está eliminando el último proceso
+// que se desconecta, se vuelve a abrir hasta crear uno nuevo con los JSON que guardó.
+bool attachSharedMemory(const std::string &name)
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    if (sharedTable.isOpen())
+    {
+        return true;
+    }
+
+    for (int intento = 0; intento < 100; ++intento)
+    {
+        json jsonRAM;
+        json jsonSwap;
+        if (!loadJsonFiles(jsonRAM, jsonSwap))
+        {
+            return false;
+        }
+
+        bool created = false;
+        if (!openSharedTable(name, jsonRAM, jsonSwap, created))
+        {
+            return false;
+        }
+        swapReadahead.clear();
+        if (created)
+        {
+            saveSharedJson(jsonRAM, jsonSwap, true);
+            sharedTable.publish();
+            return true;
+        }
+        {
+            MemoryLock shared;
+            if (sharedTable.attach())
+            {
+                return true;
+            }
+            if (!sharedTable.getHeader()->removed)
+            {
+                sharedTable.close();
+                return false;
+            }
+        }
+        sharedTable.close();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::cerr << "No se pudo conectar a la memoria compartida " << name << std::endl;
+    return false;
+}
+
+// Función para desconectarse de la memoria compartida. El último proceso en salir guarda
+// el estado en RAM.json y Swap.json con el mutex de escritura tomado, así ningún otro
+// proceso modifica la memoria compartida entre la lectura y el guardado, y solo elimina el
+// segmento si los JSON se guardaron; si no, el estado queda en el segmento para el próximo
+// proceso que se conecte (en Windows se pierde al cerrarse el último handle).
+void detachSharedMemory()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    if (!sharedTable.isOpen())
+    {
+        return;
+    }
+
+    {
+        MemoryLock shared;
+        if (sharedTable.detach())
+        {
+            json jsonRAM;
+            json jsonSwap;
+            if (loadSharedJson(jsonRAM, jsonSwap) && saveJsonFiles(jsonRAM, jsonSwap, true))
+            {
+                sharedTable.remove();
+            }
+            else
+            {
+                std::cerr << "No se pudo guardar el estado de la memoria compartida en los JSON" << std::endl;
+            }
+        }
+    }
+    swapReadahead.clear();
+    sharedTable.close();
+}
+
+SharedMemoryStatus getSharedMemoryStatus()
+{
+    std::lock_guard<std::recursive_mutex> lock(memoryMutex);
+    SharedMemoryStatus status;
+    if (sharedTable.isOpen())
+    {
+        SharedHeader *header = sharedTable.getHeader();
+        status.attached = true;
+        status.processes = static_cast<int>(header->attached.load());
+        status.ram_frames = static_cast<int>(header->ram_frames);
+        status.swap_frames = static_cast<int>(header->swap_frames);
+        status.tables_size = static_cast<int>(header->tables_size);
+        status.tables_capacity = static_cast<int>(header->tables_capacity);
+    }
+    return status;
 }
@@ -1,8 +1,10 @@
 #ifndef MEMORY_MANAGER_H
 #define MEMORY_MANAGER_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
+#include "MemoryGeometry.h"
 
 struct Frame {
     std::string content;
@@ -13,11 +15,249 @@ struct Frame {
     int segment_id;
 };
 
+// Solicitud de asignación de memoria para un proceso dentro de un lote
+struct AllocationRequest {
+    int process_id;
+    std::string programPath; // Vacío para usar el programa de ejemplo
+};
+
+// Configuración y estadísticas del reclaimer de páginas en segundo plano.
+// Las marcas de agua se expresan en frames libres de RAM.
+struct ReclaimStats {
+    int low_watermark = 1;
+    int high_watermark = 2;
+    bool running = false;
+    long pages_scanned = 0;   // Frames inspeccionados por el reloj
+    long pages_reclaimed = 0; // Páginas desalojadas a Swap
+    long stalls = 0;          // Fallos de página que tuvieron que desalojar de forma síncrona
+};
+
+// Pool de frames de RAM libres y limpios. Un frame liberado conserva su contenido hasta que
+// se guarda la operación que lo liberó, que lo limpia al guardar el estado; si la misma
+// operación necesita un frame reusa ese y lo sobrescribe, sin limpiarlo.
+struct ZeroPoolStats {
+    int ready_frames = 0;    // Frames libres y limpios (profundidad del pool)
+    long frames_zeroed = 0;  // Frames limpiados al guardar
+    long pool_hits = 0;      // Asignaciones que tomaron un frame del pool
+    long reused_frames = 0;  // Asignaciones que reusaron un frame liberado en la misma operación
+};
+
+// Controlador de frecuencia de fallos (PFF). Con el controlador activo cada proceso tiene
+// un presupuesto de frames residentes y reemplaza su página menos usada recientemente;
+// el tiempo se mide en referencias del propio proceso.
+struct PFFConfig {
+    bool enabled = false;
+    int window = 10;          // Referencias que definen el working set
+    int grow_interval = 4;    // Fallos más seguidos que esto agrandan el presupuesto
+    int shrink_interval = 12; // Fallos más espaciados que esto lo achican
+    int min_frames = 1;
+    int max_frames = 6;
+};
+
+// Detector de thrashing: mira la proporción de fallos en las últimas window referencias
+// de todos los procesos. Con el control de carga activo suspende procesos de baja
+// prioridad mientras dura el thrashing y los reanuda cuando baja la presión.
+struct LoadControlConfig {
+    bool enabled = false;
+    int window = 32;            // Referencias observadas
+    double thrash_ratio = 0.5;  // Fallos / referencias a partir de la cual hay thrashing
+    double calm_ratio = 0.2;    // Por debajo de esta proporción se reanuda un proceso
+};
+
+struct ThrashingStats {
+    bool thrashing = false;
+    double fault_ratio = 0;       // Proporción de fallos en la ventana actual
+    long episodes = 0;
+    double total_seconds = 0;     // Tiempo total en thrashing (episodios terminados y el actual)
+    double longest_seconds = 0;
+    double current_seconds = 0;   // Duración del episodio en curso
+    long suspensions = 0;
+    long resumes = 0;
+    std::vector<int> suspended;   // Procesos suspendidos por el control de carga
+};
+
+// Contadores del camino de falta de memoria (OOM): al no entrar un proceso se desalojan
+// páginas de RAM y, si la Swap está llena, se terminan procesos hasta que entre
+struct OomStats {
+    long reclaims = 0;    // Cargas que entraron o siguieron tras desalojar páginas
+    long kills = 0;       // Procesos terminados para hacer lugar
+    long failures = 0;    // Cargas que no entraron ni terminando procesos
+    int last_victim = 0;  // Último proceso terminado (0 si ninguno)
+};
+
+// Proceso candidato a ser terminado por falta de memoria
+struct OomCandidateInfo {
+    int process_id = 0;
+    int priority = 0;
+    int ram_frames = 0;
+    int swap_frames = 0;
+};
+
+// Working set y presupuesto de frames de un proceso
+struct WorkingSetInfo {
+    int process_id = 0;
+    int resident_pages = 0;
+    int working_set = 0;      // Páginas distintas referenciadas en la ventana
+    int frame_budget = 0;
+    long references = 0;
+    long faults = 0;
+};
+
+// Contadores de escritura a Swap al desalojar páginas
+struct WritebackStats {
+    long writebacks = 0;           // Páginas sucias copiadas de vuelta a Swap
+    long writebacks_avoided = 0;   // Páginas limpias desalojadas sin escribir
+    long writebacks_identical = 0; // Páginas sucias cuyo contenido ya estaba igual en Swap
+    long unchanged_writes = 0;     // Escrituras con el mismo contenido, que no ensuciaron la página
+    int cached_pages = 0;          // Páginas en RAM con su copia de Swap vigente (caché de Swap)
+    int dirty_pages = 0;           // Páginas en RAM más nuevas que su copia de Swap
+};
+
+// Carga perezosa: las páginas de los procesos cargados con este modo reciben sus frames
+// de RAM y Swap en el primer acceso, sacando el contenido de la imagen del programa
+struct LazyAllocationStats {
+    bool enabled = false;
+    long pages_materialized = 0; // Páginas que ya recibieron sus frames
+    int pending_pages = 0;       // Páginas todavía sin frames
+};
+
+// Contadores de la caché de programas segmentados
+struct ProgramCacheStats {
+    long hits = 0;          // Programas sin cambios, resueltos sin leer el archivo
+    long content_hits = 0;  // Archivo leído pero con un contenido ya segmentado
+    long misses = 0;        // Programas leídos y segmentados
+    int entries = 0;        // Imágenes guardadas en la caché
+};
+
+// Operaciones de memoria instrumentadas
+enum class MemoryOperation {
+    Allocate,
+    AllocateBatch,
+    Release,
+    Swap,
+    Read,
+    Write,
+    GetPage,
+    GetPages,
+    UpdateTable,
+    Count
+};
+
+// Latencias de una operación. Los percentiles salen del histograma logarítmico, con un
+// error relativo menor al 12,5%.
+struct OperationStats {
+    std::string name;
+    uint64_t count = 0;
+    uint64_t bytes = 0;       // Contenido de páginas leído, escrito o cargado
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p90_ns = 0;
+    uint64_t p99_ns = 0;
+};
+
+struct MemoryStats {
+    std::vector<OperationStats> operations;
+    uint64_t page_faults = 0;     // Páginas traídas de Swap a RAM
+    uint64_t evictions = 0;       // Páginas sacadas de RAM
+    uint64_t bytes_swapped_in = 0;
+    uint64_t bytes_written_back = 0;
+    uint64_t readahead_pages = 0; // Páginas leídas de Swap junto con la del fallo
+    uint64_t readahead_hits = 0;  // Fallos que encontraron su página ya leída
+};
+
+// Segmento de solo lectura compartido por los procesos que cargan el mismo programa
+struct SharedSegmentInfo {
+    int shared_id = 0;      // Id negativo que tienen sus frames como process_id
+    int segment_id = 0;
+    int refcount = 0;       // Procesos que lo usan
+    int pages = 0;
+    int resident_pages = 0; // Páginas en RAM
+};
+
+// Métricas de fragmentación del área de Swap
+struct SwapFragmentation {
+    int total_slots = 0;
+    int free_slots = 0;
+    int free_extents = 0;               // Bloques de slots libres consecutivos
+    int largest_free_extent = 0;
+    double external_fragmentation = 0;  // 1 - bloque libre más grande / slots libres
+    int segments = 0;                   // Segmentos cargados en Swap
+    int contiguous_segments = 0;        // Segmentos cuyas páginas ocupan slots consecutivos
+};
+
+// Tiempos de carga de una imagen de frames con el lector SAX y con el DOM
+struct FrameLoadBenchmark {
+    int frames = 0;
+    double dom_seconds = 0;
+    double sax_seconds = 0;
+    bool ok = false;
+};
+
+// Tiempos de traducción de direcciones con la geometría especializada en compilación y
+// con la genérica, sobre las mismas direcciones
+struct AddressTranslationBenchmark {
+    int addresses = 0;
+    int page_size = 0;
+    bool specialized = false;     // false si el tamaño de página no tiene especialización
+    double specialized_seconds = 0;
+    double generic_seconds = 0;
+    bool ok = false;              // Ambos caminos dieron las mismas traducciones
+};
+
+// Estado de la traza binaria de eventos de memoria
+struct MemoryTraceStatus {
+    bool active = false;
+    std::string path;
+    uint64_t recorded = 0; // Eventos producidos desde que empezó la traza
+    uint64_t written = 0;  // Eventos ya escritos en el archivo
+    uint64_t dropped = 0;  // Eventos descartados con el buffer lleno
+};
+
+// Uso y latencia de un dispositivo de Swap (un archivo de slots de tamaño fijo)
+struct SwapDeviceStatus {
+    std::string path;
+    int priority = 0;        // Los de mayor prioridad se llenan primero
+    int first_slot = 0;      // Primer frame de Swap.json que cubre
+    int slots = 0;
+    int used_slots = 0;
+    bool direct_io = false;  // E/S sin la caché del sistema (O_DIRECT / FILE_FLAG_NO_BUFFERING)
+    uint64_t reads = 0;      // Lecturas: una por página o bloque de páginas
+    uint64_t writes = 0;
+    uint64_t read_avg_ns = 0;
+    uint64_t read_p99_ns = 0;
+    uint64_t write_avg_ns = 0;
+    uint64_t write_p99_ns = 0;
+};
+
+// Estado de la conexión a la memoria compartida entre la CLI y la GUI
+struct SharedMemoryStatus {
+    bool attached = false;
+    int processes = 0;       // Procesos conectados al segmento
+    int ram_frames = 0;
+    int swap_frames = 0;
+    int tables_size = 0;     // Bytes usados por las tablas de páginas serializadas
+    int tables_capacity = 0;
+};
+
+// Memoria de un proceso en frames. Los frames compartidos se cuentan en cada proceso que
+// los usa; proportional_kb los reparte entre los que los comparten (PSS).
+struct ProcessMemoryUsage {
+    int process_id = 0;
+    int ram_frames = 0;          // Frames privados en RAM
+    int swap_frames = 0;         // Slots privados en Swap
+    int shared_ram_frames = 0;   // Frames de código compartido en RAM
+    int shared_swap_frames = 0;
+    double proportional_kb = 0;  // RAM privada + RAM compartida / procesos que la comparten
+    bool suspended = false;
+};
+
 class MemoryCalculator {
 public:
     MemoryCalculator(const std::vector<Frame>& frames);
     int calculateAvailableMemory();
     int calculateMemoryUsedByProcess(int process_id);
+    static int frameSize() { return FRAME_SIZE; }
 
 private:
     std::vector<Frame> frames;
@@ -26,16 +266,82 @@ private:
 
 // Funciones principales que se usarán en la CLI
 bool memoryAllocation(int process_id);
+bool allocateBatch(const std::vector<AllocationRequest>& requests);
 void releaseMemory(int process_id);
 bool memorySwap(int segmento, int pagina, int process_id);
+bool memoryRead(int segmento, int pagina, int process_id, std::string& content);
+bool memoryWrite(int segmento, int pagina, int process_id, const std::string& data);
+// Direcciones virtuales: [segmento | página | desplazamiento] con páginas de 50 caracteres
+VirtualAddress translateAddress(uint64_t address);
+bool memoryReadAddress(int process_id, uint64_t address, std::string& content);
+WritebackStats getWritebackStats();
+MemoryStats getMemoryStats();
+void resetMemoryStats();
+bool exportMemoryStats(const std::string& path); // Guarda las estadísticas y los histogramas en JSON
+ProgramCacheStats getProgramCacheStats();
+void setLazyAllocation(bool enabled);
+LazyAllocationStats getLazyAllocationStats();
+void clearProgramCache();
 int freeMem();
+int ramFrameCount();
+
+// Reclaimer en segundo plano que mantiene frames libres entre las marcas de agua
+void startReclaimer();
+void stopReclaimer();
+void setReclaimWatermarks(int low, int high);
+ReclaimStats getReclaimStats();
+
+// Frames libres y limpios, y cuántas asignaciones los usaron
+ZeroPoolStats getZeroPoolStats();
+
+// Traza binaria de cargas, liberaciones, fallos, desalojos y lecturas de Swap
+bool startMemoryTrace(const std::string& path, int capacity = 65536);
+void stopMemoryTrace();
+MemoryTraceStatus getMemoryTraceStatus();
+
+// Asignación de frames por working set y frecuencia de fallos
+void setPFFConfig(const PFFConfig& config);
+PFFConfig getPFFConfig();
+std::vector<WorkingSetInfo> getWorkingSets();
+
+// Detección de thrashing y control de carga. La prioridad por defecto es 0; se suspenden
+// primero los procesos de menor prioridad.
+void setLoadControlConfig(const LoadControlConfig& config);
+LoadControlConfig getLoadControlConfig();
+ThrashingStats getThrashingStats();
+bool setMemoryPriority(int process_id, int priority);
+bool resumeProcessMemory(int process_id);
+
+// Falta de memoria: la víctima es el proceso de menor prioridad y, entre iguales, el que más
+// frames ocupa entre RAM y Swap. getOomRanking los devuelve en el orden en que se terminarían.
+OomStats getOomStats();
+std::vector<OomCandidateInfo> getOomRanking();
+
+// Memoria compartida: mientras está conectada el estado vive en el segmento y no en los JSON
+bool attachSharedMemory(const std::string& name = "gui_cli_so_memory");
+void detachSharedMemory();
+SharedMemoryStatus getSharedMemoryStatus();
 
 // Funciones auxiliares
 std::vector<Frame> loadFramesFromJson(const std::string& filename);
+FrameLoadBenchmark benchmarkFrameLoad(int frameCount, const std::string& imagePath);
+AddressTranslationBenchmark benchmarkAddressTranslation(int count, int pageSize);
 std::vector<std::string> pagination(const std::string& text, int size);
 int countLines(const std::string& filePath);
 void uploadToRam(const std::vector<std::vector<std::string>>& segments, int process_id);
 std::string getPage(int frame_number);
-void updateTable(int segmento, int pagina, int process_id, int new_page_ram_frame);
+std::vector<std::string> getPages(int first_frame, int count);
+SwapFragmentation getSwapFragmentation();
+// Dispositivos de Swap: archivos de slots con prioridad; los de igual prioridad se turnan
+bool addSwapDevice(const std::string& path, int slots, int priority);
+bool removeSwapDevice(const std::string& path);
+bool setSwapDevicePriority(const std::string& path, int priority);
+bool setSwapDirectIO(bool enabled);
+std::vector<SwapDeviceStatus> getSwapDevices();
+// Reporte de memoria de todos los procesos, de mayor a menor PSS (RAM privada más la parte
+// proporcional de la compartida) y, a igual PSS, de mayor a menor uso de Swap
+std::vector<ProcessMemoryUsage> getProcessMemoryReport();
+std::vector<SharedSegmentInfo> getSharedSegments();
+bool updateTable(int segmento, int pagina, int process_id, int new_page_ram_frame);
 
 #endif // MEMORY_MANAGER_H
\ No newline at end of file
@@ -0,0 +1,519 @@
+#include "MemorySimulator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <unordered_map>
+
+using namespace std;
+
+// Función para leer una traza binaria completa con una sola lectura
+bool loadTrace(const string &path, vector<TraceRecord> &trace)
+{
+    ifstream file(path, ios::binary | ios::ate);
+    if (!file.is_open())
+    {
+        cerr << "No se pudo abrir la traza: " << path << endl;
+        return false;
+    }
+
+    streamsize size = file.tellg();
+    if (size % sizeof(TraceRecord) != 0)
+    {
+        cerr << "Traza truncada o con formato inválido: " << path << endl;
+        return false;
+    }
+
+    trace.resize(size / sizeof(TraceRecord));
+    file.seekg(0);
+    file.read(reinterpret_cast<char *>(trace.data()), size);
+    return static_cast<bool>(file);
+}
+
+bool saveTrace(const string &path, const vector<TraceRecord> &trace)
+{
+    ofstream file(path, ios::binary);
+    if (!file.is_open())
+    {
+        cerr << "No se pudo crear la traza: " << path << endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char *>(trace.data()), trace.size() * sizeof(TraceRecord));
+    return static_cast<bool>(file);
+}
+
+// Función para renumerar las páginas y segmentos de la traza de forma densa
+CompiledTrace compileTrace(const vector<TraceRecord> &trace, int pageSize)
+{
+    // Cuántas páginas de la traza caben en una página del tamaño pedido
+    const uint32_t pagesPerPage = pageSize > TRACE_PAGE_SIZE ? static_cast<uint32_t>(pageSize / TRACE_PAGE_SIZE) : 1;
+
+    CompiledTrace compiled;
+    compiled.pages.reserve(trace.size());
+    compiled.writes.reserve(trace.size());
+
+    // Clave de segmento: process_id en los 32 bits altos, segment_id en los bajos
+    unordered_map<uint64_t, uint32_t> segmentIds;
+    // Páginas de cada segmento denso
+    vector<unordered_map<uint32_t, uint32_t>> pageIds;
+
+    for (const auto &record : trace)
+    {
+        uint64_t segmentKey = (static_cast<uint64_t>(record.process_id) << 32) | record.segment_id;
+        auto segmentIt = segmentIds.find(segmentKey);
+        if (segmentIt == segmentIds.end())
+        {
+            segmentIt = segmentIds.emplace(segmentKey, compiled.segment_count++).first;
+            pageIds.emplace_back();
+        }
+
+        auto &segmentPages = pageIds[segmentIt->second];
+        // Las páginas se numeran desde 1
+        uint32_t pageNumber = record.page_number > 0 ? (record.page_number - 1) / pagesPerPage + 1 : 0;
+        auto pageIt = segmentPages.find(pageNumber);
+        if (pageIt == segmentPages.end())
+        {
+            pageIt = segmentPages.emplace(pageNumber, compiled.page_count++).first;
+            compiled.page_segment.push_back(segmentIt->second);
+        }
+
+        compiled.pages.push_back(pageIt->second);
+        compiled.writes.push_back((record.flags & TRACE_WRITE) ? 1 : 0);
+    }
+    return compiled;
+}
+
+bool parseReplacementPolicy(const string &name, ReplacementPolicy &policy)
+{
+    if (name == "local")
+        policy = ReplacementPolicy::Local;
+    else if (name == "fifo")
+        policy = ReplacementPolicy::FIFO;
+    else if (name == "lru")
+        policy = ReplacementPolicy::LRU;
+    else if (name == "clock")
+        policy = ReplacementPolicy::Clock;
+    else if (name == "opt")
+        policy = ReplacementPolicy::OPT;
+    else
+        return false;
+    return true;
+}
+
+const char *replacementPolicyName(ReplacementPolicy policy)
+{
+    switch (policy)
+    {
+    case ReplacementPolicy::Local:
+        return "local";
+    case ReplacementPolicy::FIFO:
+        return "fifo";
+    case ReplacementPolicy::LRU:
+        return "lru";
+    case ReplacementPolicy::Clock:
+        return "clock";
+    case ReplacementPolicy::OPT:
+        return "opt";
+    }
+    return "?";
+}
+
+MemorySimulator::MemorySimulator(const SimulationConfig &config) : config(config) {}
+
+SimulationResult MemorySimulator::run(const CompiledTrace &trace)
+{
+    SimulationResult result;
+    if (config.ram_frames <= 0)
+    {
+        cerr << "El simulador necesita al menos un frame de RAM" << endl;
+        return result;
+    }
+
+    // Todo el estado se reserva aquí; el bucle de simulación no reserva memoria
+    size_t frames = static_cast<size_t>(config.ram_frames);
+    frameOfPage.assign(trace.page_count, -1);
+    pageInFrame.assign(frames, -1);
+    dirty.assign(frames, 0);
+    referenced.assign(frames, 0);
+    lruPrev.assign(frames, -1);
+    lruNext.assign(frames, -1);
+    segmentFrame.assign(trace.segment_count, -1);
+    if (config.policy == ReplacementPolicy::OPT)
+    {
+        nextUse.assign(trace.pages.size(), 0);
+        frameNextUse.assign(frames, 0);
+        optHeap.clear();
+        optHeap.reserve(4 * frames + 1);
+    }
+
+    auto start = chrono::steady_clock::now();
+    switch (config.policy)
+    {
+    case ReplacementPolicy::Local:
+        simulate<ReplacementPolicy::Local>(trace, result);
+        break;
+    case ReplacementPolicy::FIFO:
+        simulate<ReplacementPolicy::FIFO>(trace, result);
+        break;
+    case ReplacementPolicy::LRU:
+        simulate<ReplacementPolicy::LRU>(trace, result);
+        break;
+    case ReplacementPolicy::Clock:
+        simulate<ReplacementPolicy::Clock>(trace, result);
+        break;
+    case ReplacementPolicy::OPT:
+        simulate<ReplacementPolicy::OPT>(trace, result);
+        break;
+    }
+    auto end = chrono::steady_clock::now();
+
+    result.accesses = trace.pages.size();
+    result.seconds = chrono::duration<double>(end - start).count();
+    if (result.seconds > 0)
+    {
+        result.accesses_per_second = result.accesses / result.seconds;
+    }
+    return result;
+}
+
+// Bucle de simulación especializado por política en tiempo de compilación
+template <ReplacementPolicy P>
+void MemorySimulator::simulate(const CompiledTrace &trace, SimulationResult &result)
+{
+    const int32_t frames = config.ram_frames;
+    int32_t used = 0;     // Frames que ya recibieron alguna página
+    int32_t hand = 0;     // Manecilla de FIFO y Clock
+    int32_t lruHead = -1; // Frame usado más recientemente
+    int32_t lruTail = -1; // Frame usado hace más tiempo
+
+    auto lruUnlink = [&](int32_t frame)
+    {
+        if (lruPrev[frame] >= 0)
+            lruNext[lruPrev[frame]] = lruNext[frame];
+        else
+            lruHead = lruNext[frame];
+        if (lruNext[frame] >= 0)
+            lruPrev[lruNext[frame]] = lruPrev[frame];
+        else
+            lruTail = lruPrev[frame];
+    };
+    auto lruPushFront = [&](int32_t frame)
+    {
+        lruPrev[frame] = -1;
+        lruNext[frame] = lruHead;
+        if (lruHead >= 0)
+            lruPrev[lruHead] = frame;
+        lruHead = frame;
+        if (lruTail < 0)
+            lruTail = frame;
+    };
+    auto clockVictim = [&]()
+    {
+        while (referenced[hand])
+        {
+            referenced[hand] = 0;
+            hand = (hand + 1) % frames;
+        }
+        int32_t victim = hand;
+        hand = (hand + 1) % frames;
+        return victim;
+    };
+
+    const size_t accesses = trace.pages.size();
+
+    // OPT: una pasada hacia atrás calcula el próximo uso de cada acceso. Las páginas
+    // que no se vuelven a usar quedan con "accesses", el valor más lejano posible.
+    // El montículo guarda (próximo uso, frame); al tocar una página se agrega una
+    // entrada nueva y las viejas se descartan al sacarlas, comparando con frameNextUse.
+    auto optRecord = [&](int32_t frame, uint32_t next)
+    {
+        frameNextUse[frame] = next;
+        if (optHeap.size() >= 4 * static_cast<size_t>(frames))
+        {
+            // Reconstruir con una sola entrada por frame para acotar el tamaño
+            optHeap.clear();
+            for (int32_t f = 0; f < used; ++f)
+            {
+                if (f != frame && pageInFrame[f] >= 0)
+                    optHeap.push_back((static_cast<uint64_t>(frameNextUse[f]) << 32) | static_cast<uint32_t>(f));
+            }
+            make_heap(optHeap.begin(), optHeap.end());
+        }
+        optHeap.push_back((static_cast<uint64_t>(next) << 32) | static_cast<uint32_t>(frame));
+        push_heap(optHeap.begin(), optHeap.end());
+    };
+    auto optVictim = [&]()
+    {
+        for (;;)
+        {
+            uint64_t top = optHeap.front();
+            pop_heap(optHeap.begin(), optHeap.end());
+            optHeap.pop_back();
+            int32_t frame = static_cast<int32_t>(top & 0xffffffffu);
+            if (frameNextUse[frame] == static_cast<uint32_t>(top >> 32))
+                return frame;
+        }
+    };
+    if constexpr (P == ReplacementPolicy::OPT)
+    {
+        vector<uint32_t> &lastSeen = frameNextUse; // Se reutiliza como temporal
+        lastSeen.assign(trace.page_count, static_cast<uint32_t>(accesses));
+        for (size_t i = accesses; i-- > 0;)
+        {
+            nextUse[i] = lastSeen[trace.pages[i]];
+            lastSeen[trace.pages[i]] = static_cast<uint32_t>(i);
+        }
+        frameNextUse.assign(frames, 0);
+    }
+
+    for (size_t i = 0; i < accesses; ++i)
+    {
+        const uint32_t page = trace.pages[i];
+        const uint8_t write = trace.writes[i];
+        int32_t frame = frameOfPage[page];
+
+        if (frame >= 0)
+        {
+            referenced[frame] = 1;
+            dirty[frame] |= write;
+            if constexpr (P == ReplacementPolicy::LRU)
+            {
+                lruUnlink(frame);
+                lruPushFront(frame);
+            }
+            if constexpr (P == ReplacementPolicy::OPT)
+            {
+                optRecord(frame, nextUse[i]);
+            }
+            continue;
+        }
+
+        result.faults++;
+        const uint32_t segment = trace.page_segment[page];
+
+        // Elegir el frame que recibe la página
+        if (P == ReplacementPolicy::Local && segmentFrame[segment] >= 0)
+            frame = segmentFrame[segment];
+        else if (used < frames)
+            frame = used++;
+        else if constexpr (P == ReplacementPolicy::FIFO)
+        {
+            frame = hand;
+            hand = (hand + 1) % frames;
+        }
+        else if constexpr (P == ReplacementPolicy::LRU)
+            frame = lruTail;
+        else if constexpr (P == ReplacementPolicy::OPT)
+            frame = optVictim();
+        else
+            frame = clockVictim();
+
+        // Desalojar la página que ocupaba el frame
+        const int32_t victim = pageInFrame[frame];
+        if (victim >= 0)
+        {
+            result.evictions++;
+            result.writebacks += dirty[frame];
+            frameOfPage[victim] = -1;
+            if constexpr (P == ReplacementPolicy::Local)
+            {
+                segmentFrame[trace.page_segment[victim]] = -1;
+            }
+            if constexpr (P == ReplacementPolicy::LRU)
+            {
+                lruUnlink(frame);
+            }
+        }
+
+        pageInFrame[frame] = static_cast<int32_t>(page);
+        frameOfPage[page] = frame;
+        dirty[frame] = write;
+        referenced[frame] = 1;
+        if constexpr (P == ReplacementPolicy::Local)
+        {
+            segmentFrame[segment] = frame;
+        }
+        if constexpr (P == ReplacementPolicy::LRU)
+        {
+            lruPushFront(frame);
+        }
+        if constexpr (P == ReplacementPolicy::OPT)
+        {
+            optRecord(frame, nextUse[i]);
+        }
+    }
+}
+
+// Función para repartir una lista de tareas entre varios hilos. Cada hilo toma la
+// siguiente tarea libre de un contador atómico hasta que no quedan más.
+template <typename Task>
+static void runOnThreads(size_t tasks, int threads, Task task)
+{
+    atomic<size_t> next(0);
+    auto worker = [&]()
+    {
+        for (size_t i = next++; i < tasks; i = next++)
+        {
+            task(i);
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 1; t < threads && static_cast<size_t>(t) < tasks; ++t)
+    {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto &th : pool)
+    {
+        th.join();
+    }
+}
+
+vector<SweepPoint> runSweep(const vector<TraceRecord> &trace,
+                            const vector<ReplacementPolicy> &policies,
+                            const vector<int> &ramFrames,
+                            const vector<int> &pageSizes,
+                            int threads)
+{
+    if (threads <= 0)
+    {
+        threads = max(1, static_cast<int>(thread::hardware_concurrency()));
+    }
+
+    // Una traza compilada por tamaño de página, compartida (solo lectura) por los puntos
+    vector<CompiledTrace> compiled(pageSizes.size());
+    runOnThreads(pageSizes.size(), threads, [&](size_t i)
+                 { compiled[i] = compileTrace(trace, pageSizes[i]); });
+
+    vector<SweepPoint> points;
+    vector<size_t> traceOfPoint;
+    for (size_t s = 0; s < pageSizes.size(); ++s)
+    {
+        for (ReplacementPolicy policy : policies)
+        {
+            for (int frames : ramFrames)
+            {
+                points.push_back({policy, frames, pageSizes[s], SimulationResult()});
+                traceOfPoint.push_back(s);
+            }
+        }
+    }
+
+    runOnThreads(points.size(), threads, [&](size_t i)
+                 {
+                     SimulationConfig config;
+                     config.policy = points[i].policy;
+                     config.ram_frames = points[i].ram_frames;
+                     MemorySimulator simulator(config);
+                     points[i].result = simulator.run(compiled[traceOfPoint[i]]); });
+    return points;
+}
+
+bool writeSweepCsv(const string &path, const vector<SweepPoint> &points)
+{
+    ofstream file(path);
+    if (!file.is_open())
+    {
+        cerr << "No se pudo crear el archivo CSV: " << path << endl;
+        return false;
+    }
+
+    file << "policy,ram_frames,page_size,accesses,faults,fault_rate,evictions,writebacks,seconds,accesses_per_second\n";
+    for (const auto &point : points)
+    {
+        const SimulationResult &r = point.result;
+        file << replacementPolicyName(point.policy) << ',' << point.ram_frames << ',' << point.page_size << ','
+             << r.accesses << ',' << r.faults << ','
+             << (r.accesses ? static_cast<double>(r.faults) / r.accesses : 0.0) << ','
+             << r.evictions << ',' << r.writebacks << ',' << r.seconds << ',' << r.accesses_per_second << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+MissRatioCurve lruMissRatioCurve(const CompiledTrace &trace, int maxFrames, double sampling)
+{
+    MissRatioCurve curve;
+    if (maxFrames <= 0)
+    {
+        return curve;
+    }
+    auto start = chrono::steady_clock::now();
+
+    // SHARDS: una página entra en la muestra si su hash cae bajo el umbral
+    const uint64_t modulus = 1 << 24;
+    const uint64_t threshold = sampling >= 1.0 ? modulus : static_cast<uint64_t>(sampling * modulus);
+    auto sampled = [&](uint32_t page)
+    {
+        return ((page * 2654435761u) & (modulus - 1)) < threshold;
+    };
+
+    // Árbol de Fenwick sobre los instantes de acceso: vale 1 en el último acceso de cada
+    // página, así la suma entre dos instantes cuenta las páginas distintas tocadas
+    const size_t n = trace.pages.size();
+    vector<uint32_t> fenwick(n + 1, 0);
+    auto add = [&](size_t position, int32_t delta)
+    {
+        for (size_t i = position + 1; i <= n; i += i & (0 - i))
+            fenwick[i] += delta;
+    };
+    auto prefix = [&](size_t position) // Suma de [0, position)
+    {
+        uint64_t total = 0;
+        for (size_t i = position; i > 0; i -= i & (0 - i))
+            total += fenwick[i];
+        return total;
+    };
+
+    // histogram[d]: accesos con distancia de pila d; los mayores que maxFrames van al final
+    vector<uint64_t> histogram(maxFrames + 2, 0);
+    vector<int64_t> lastAccess(trace.page_count, -1);
+    const double scale = sampling >= 1.0 ? 1.0 : 1.0 / sampling;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const uint32_t page = trace.pages[i];
+        if (threshold < modulus && !sampled(page))
+        {
+            continue;
+        }
+        curve.accesses++;
+
+        if (lastAccess[page] < 0)
+        {
+            curve.cold_misses++;
+        }
+        else
+        {
+            size_t last = static_cast<size_t>(lastAccess[page]);
+            // Páginas distintas desde el acceso anterior, contando a la propia página
+            uint64_t distance = prefix(i) - prefix(last + 1) + 1;
+            uint64_t scaled = static_cast<uint64_t>(distance * scale);
+            histogram[min<uint64_t>(scaled, maxFrames + 1)]++;
+            add(last, -1);
+        }
+        add(i, 1);
+        lastAccess[page] = static_cast<int64_t>(i);
+    }
+
+    // Con c frames falla todo acceso cuya distancia sea mayor que c
+    curve.miss_ratio.assign(maxFrames + 1, 0);
+    uint64_t misses = curve.cold_misses;
+    for (size_t d = histogram.size() - 1; d > 1; --d)
+    {
+        misses += histogram[d];
+        if (d - 1 <= static_cast<size_t>(maxFrames))
+        {
+            curve.miss_ratio[d - 1] = curve.accesses ? static_cast<double>(misses) / curve.accesses : 0;
+        }
+    }
+    if (curve.accesses)
+    {
+        curve.miss_ratio[0] = 1.0;
+    }
+
+    curve.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return curve;
+}
@@ -0,0 +1,116 @@
+#ifndef MEMORY_SIMULATOR_H
+#define MEMORY_SIMULATOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Registro de un acceso en una traza binaria: 12 bytes little-endian por acceso
+#pragma pack(push, 1)
+struct TraceRecord {
+    uint32_t process_id;
+    uint16_t segment_id;
+    uint16_t flags;        // Bit 0: escritura
+    uint32_t page_number;
+};
+#pragma pack(pop)
+
+static const uint16_t TRACE_WRITE = 1;
+static const int TRACE_PAGE_SIZE = 50; // Tamaño de página con el que se numeran las páginas de la traza
+
+enum class ReplacementPolicy {
+    Local, // La de memorySwap: la página residente del segmento sale de RAM
+    FIFO,
+    LRU,
+    Clock, // Segunda oportunidad, la del reclaimer
+    OPT    // Belady: desaloja la página que se usará más tarde (necesita la traza completa)
+};
+
+struct SimulationConfig {
+    ReplacementPolicy policy = ReplacementPolicy::Local;
+    int ram_frames = 8;
+};
+
+struct SimulationResult {
+    uint64_t accesses = 0;
+    uint64_t faults = 0;
+    uint64_t evictions = 0;
+    uint64_t writebacks = 0;  // Desalojos de páginas sucias
+    double seconds = 0;       // Tiempo del bucle de simulación
+    double accesses_per_second = 0;
+};
+
+// Traza con las páginas renumeradas de forma densa (0..page_count-1), para que el
+// simulador use solo arreglos indexados y no reserve memoria durante la simulación
+struct CompiledTrace {
+    std::vector<uint32_t> pages;          // Página densa de cada acceso
+    std::vector<uint8_t> writes;          // 1 si el acceso es de escritura
+    std::vector<uint32_t> page_segment;   // Segmento denso de cada página
+    uint32_t page_count = 0;
+    uint32_t segment_count = 0;
+};
+
+bool loadTrace(const std::string& path, std::vector<TraceRecord>& trace);
+bool saveTrace(const std::string& path, const std::vector<TraceRecord>& trace);
+// pageSize debe ser múltiplo de TRACE_PAGE_SIZE: las páginas de la traza se agrupan en
+// páginas más grandes (la traza no tiene desplazamientos para dividirlas)
+CompiledTrace compileTrace(const std::vector<TraceRecord>& trace, int pageSize = TRACE_PAGE_SIZE);
+
+bool parseReplacementPolicy(const std::string& name, ReplacementPolicy& policy);
+const char* replacementPolicyName(ReplacementPolicy policy);
+
+// Simulador en memoria de las tablas de páginas y la política de reemplazo.
+// No toca RAM.json ni Swap.json, así que se pueden usar varias instancias a la vez.
+class MemorySimulator {
+public:
+    MemorySimulator(const SimulationConfig& config);
+    SimulationResult run(const CompiledTrace& trace);
+
+private:
+    template <ReplacementPolicy P>
+    void simulate(const CompiledTrace& trace, SimulationResult& result);
+
+    SimulationConfig config;
+    std::vector<int32_t> frameOfPage;     // Frame de cada página, -1 si no está en RAM
+    std::vector<int32_t> pageInFrame;     // Página de cada frame
+    std::vector<uint8_t> dirty;           // Bit de modificado por frame
+    std::vector<uint8_t> referenced;      // Bit de referencia por frame
+    std::vector<int32_t> lruPrev;         // Lista LRU doblemente enlazada sobre frames
+    std::vector<int32_t> lruNext;
+    std::vector<int32_t> segmentFrame;    // Frame residente de cada segmento (política Local)
+    std::vector<uint32_t> nextUse;        // Próximo acceso a la misma página (política OPT)
+    std::vector<uint32_t> frameNextUse;   // Próximo uso de la página de cada frame
+    std::vector<uint64_t> optHeap;        // Montículo (próximo uso, frame) con entradas viejas
+};
+
+// Punto de un barrido de parámetros y su resultado
+struct SweepPoint {
+    ReplacementPolicy policy;
+    int ram_frames;
+    int page_size;
+    SimulationResult result;
+};
+
+// Función para correr la misma traza sobre la grilla política × frames × tamaño de página.
+// Cada punto usa su propio MemorySimulator y se reparte entre threads hilos.
+std::vector<SweepPoint> runSweep(const std::vector<TraceRecord>& trace,
+                                 const std::vector<ReplacementPolicy>& policies,
+                                 const std::vector<int>& ramFrames,
+                                 const std::vector<int>& pageSizes,
+                                 int threads);
+bool writeSweepCsv(const std::string& path, const std::vector<SweepPoint>& points);
+
+// Curva de tasa de fallos LRU para todos los tamaños de RAM a la vez
+struct MissRatioCurve {
+    std::vector<double> miss_ratio; // miss_ratio[c]: tasa de fallos con c frames (índice 0 sin usar)
+    uint64_t accesses = 0;          // Accesos analizados (los muestreados si sampling < 1)
+    uint64_t cold_misses = 0;       // Primer acceso a cada página
+    double seconds = 0;
+};
+
+// Función para calcular la curva con distancias de pila de Mattson en una sola pasada.
+// Con sampling < 1 solo se analizan las páginas cuyo hash cae en esa fracción (SHARDS)
+// y las distancias se escalan por 1 / sampling.
+MissRatioCurve lruMissRatioCurve(const CompiledTrace& trace, int maxFrames, double sampling = 1.0);
+
+#endif // MEMORY_SIMULATOR_H
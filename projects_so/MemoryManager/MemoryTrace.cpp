@@ -0,0 +1,203 @@
+#include "MemoryTrace.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+static const char TRACE_MAGIC[8] = {'M', 'E', 'M', 'E', 'V', 'E', 'N', 'T'};
+static const uint32_t TRACE_VERSION = 1;
+static const auto FLUSH_INTERVAL = chrono::milliseconds(50);
+
+MemoryTraceWriter::~MemoryTraceWriter()
+{
+    stop();
+}
+
+bool MemoryTraceWriter::start(const string &path, size_t capacity)
+{
+    if (active())
+    {
+        cerr << "Ya hay una traza en curso: " << tracePath << endl;
+        return false;
+    }
+
+    file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        cerr << "No se pudo crear la traza: " << path << endl;
+        return false;
+    }
+    // Cabecera: firma, versión y tamaño de cada evento
+    uint32_t header[2] = {TRACE_VERSION, static_cast<uint32_t>(sizeof(MemoryEvent))};
+    fwrite(TRACE_MAGIC, 1, sizeof(TRACE_MAGIC), file);
+    fwrite(header, sizeof(uint32_t), 2, file);
+
+    // La capacidad se redondea a potencia de 2 para indexar con una máscara
+    size_t size = 1;
+    while (size < capacity)
+    {
+        size <<= 1;
+    }
+    buffer.assign(size, MemoryEvent());
+    mask = size - 1;
+    head = 0;
+    tail = 0;
+    writtenEvents = 0;
+    droppedEvents = 0;
+    tracePath = path;
+    startTime = chrono::steady_clock::now();
+    stopRequested = false;
+    running = true;
+    flusher = thread(&MemoryTraceWriter::flushLoop, this);
+    return true;
+}
+
+void MemoryTraceWriter::stop()
+{
+    if (!flusher.joinable())
+    {
+        return;
+    }
+    running = false;
+    {
+        lock_guard<mutex> lock(wakeMutex);
+        stopRequested = true;
+    }
+    wakeup.notify_one();
+    flusher.join();
+    fclose(file);
+    file = nullptr;
+}
+
+void MemoryTraceWriter::record(MemoryEventType type, int process_id, int segment_id, int page_number,
+                               int ram_frame, int swap_slot, uint8_t flags)
+{
+    if (!active())
+    {
+        return;
+    }
+
+    uint64_t position = head.load(memory_order_relaxed);
+    if (position - tail.load(memory_order_acquire) > mask)
+    {
+        droppedEvents.fetch_add(1, memory_order_relaxed);
+        return;
+    }
+
+    MemoryEvent &event = buffer[position & mask];
+    event.timestamp_ns = static_cast<uint64_t>(
+        chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - startTime).count());
+    event.process_id = process_id;
+    event.page_number = static_cast<uint32_t>(page_number);
+    event.ram_frame = ram_frame;
+    event.swap_slot = swap_slot;
+    event.segment_id = static_cast<uint16_t>(segment_id);
+    event.type = static_cast<uint8_t>(type);
+    event.flags = flags;
+    head.store(position + 1, memory_order_release);
+
+    // Con medio buffer ocupado no se espera al próximo intervalo
+    if (((position + 1) & (mask >> 1)) == 0)
+    {
+        wakeup.notify_one();
+    }
+}
+
+// Función para escribir en el archivo los eventos pendientes, en a lo sumo dos bloques
+void MemoryTraceWriter::drain()
+{
+    uint64_t first = tail.load(memory_order_relaxed);
+    uint64_t last = head.load(memory_order_acquire);
+    while (first < last)
+    {
+        size_t index = static_cast<size_t>(first & mask);
+        size_t count = static_cast<size_t>(min<uint64_t>(last - first, buffer.size() - index));
+        fwrite(&buffer[index], sizeof(MemoryEvent), count, file);
+        first += count;
+        writtenEvents.fetch_add(count, memory_order_relaxed);
+    }
+    tail.store(last, memory_order_release);
+    fflush(file);
+}
+
+void MemoryTraceWriter::flushLoop()
+{
+    unique_lock<mutex> lock(wakeMutex);
+    while (!stopRequested)
+    {
+        wakeup.wait_for(lock, FLUSH_INTERVAL);
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+    lock.unlock();
+    drain();
+}
+
+bool readMemoryTrace(const string &path, vector<MemoryEvent> &events)
+{
+    ifstream input(path, ios::binary);
+    if (!input.is_open())
+    {
+        cerr << "No se pudo abrir la traza: " << path << endl;
+        return false;
+    }
+
+    char magic[sizeof(TRACE_MAGIC)];
+    uint32_t header[2] = {0, 0};
+    input.read(magic, sizeof(magic));
+    input.read(reinterpret_cast<char *>(header), sizeof(header));
+    if (!input || memcmp(magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0 || header[0] != TRACE_VERSION ||
+        header[1] != sizeof(MemoryEvent))
+    {
+        cerr << "El archivo no es una traza de eventos de memoria válida: " << path << endl;
+        return false;
+    }
+
+    input.seekg(0, ios::end);
+    streamoff bytes = input.tellg() - static_cast<streamoff>(sizeof(TRACE_MAGIC) + sizeof(header));
+    input.seekg(sizeof(TRACE_MAGIC) + sizeof(header), ios::beg);
+    events.resize(static_cast<size_t>(bytes / sizeof(MemoryEvent)));
+    input.read(reinterpret_cast<char *>(events.data()), events.size() * sizeof(MemoryEvent));
+    return static_cast<bool>(input);
+}
+
+bool writeMemoryTraceCsv(const string &path, const vector<MemoryEvent> &events)
+{
+    ofstream file(path);
+    if (!file.is_open())
+    {
+        cerr << "No se pudo crear el archivo CSV: " << path << endl;
+        return false;
+    }
+
+    file << "timestamp_ns,event,process_id,segment_id,page_number,ram_frame,swap_slot,writeback\n";
+    for (const auto &event : events)
+    {
+        file << event.timestamp_ns << ',' << memoryEventTypeName(event.type) << ',' << event.process_id << ','
+             << event.segment_id << ',' << event.page_number << ',' << event.ram_frame << ',' << event.swap_slot << ','
+             << ((event.flags & MEMORY_EVENT_WRITEBACK) ? 1 : 0) << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+const char *memoryEventTypeName(uint8_t type)
+{
+    switch (static_cast<MemoryEventType>(type))
+    {
+    case MemoryEventType::Allocate:
+        return "allocate";
+    case MemoryEventType::Free:
+        return "free";
+    case MemoryEventType::PageFault:
+        return "fault";
+    case MemoryEventType::SwapIn:
+        return "swap-in";
+    case MemoryEventType::Eviction:
+        return "evict";
+    case MemoryEventType::Materialize:
+        return "materialize";
+    }
+    return "?";
+}
@@ -0,0 +1,84 @@
+#ifndef MEMORY_TRACE_H
+#define MEMORY_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class MemoryEventType : uint8_t {
+    Allocate = 1,    // Proceso cargado; page_number tiene la cantidad de páginas
+    Free = 2,        // Memoria del proceso liberada
+    PageFault = 3,   // Acceso a una página que no estaba en RAM
+    SwapIn = 4,      // Página copiada de Swap a un frame de RAM
+    Eviction = 5,    // Página sacada de RAM; flags bit 0: se escribió en Swap
+    Materialize = 6  // Página perezosa que recibió su slot de Swap
+};
+
+static const uint8_t MEMORY_EVENT_WRITEBACK = 1;
+
+// Evento de la traza binaria: 28 bytes little-endian por evento
+#pragma pack(push, 1)
+struct MemoryEvent {
+    uint64_t timestamp_ns; // Desde el inicio de la traza
+    int32_t process_id;    // Negativo para segmentos compartidos
+    uint32_t page_number;
+    int32_t ram_frame;     // -1 si no aplica
+    int32_t swap_slot;     // -1 si no aplica
+    uint16_t segment_id;
+    uint8_t type;          // MemoryEventType
+    uint8_t flags;
+};
+#pragma pack(pop)
+
+// Traza binaria de eventos de memoria. Los eventos van a un buffer circular y un hilo los
+// escribe en el archivo, así registrar un evento no hace E/S. Si el buffer se llena los
+// eventos nuevos se descartan y se cuentan. Un solo productor a la vez: MemoryManager
+// registra siempre con memoryMutex tomado.
+class MemoryTraceWriter {
+public:
+    ~MemoryTraceWriter();
+
+    bool start(const std::string& path, size_t capacity);
+    void stop();
+    bool active() const { return running.load(std::memory_order_relaxed); }
+
+    void record(MemoryEventType type, int process_id, int segment_id, int page_number,
+                int ram_frame = -1, int swap_slot = -1, uint8_t flags = 0);
+
+    std::string path() const { return tracePath; }
+    uint64_t recorded() const { return head.load(std::memory_order_relaxed) + droppedEvents.load(std::memory_order_relaxed); }
+    uint64_t written() const { return writtenEvents.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return droppedEvents.load(std::memory_order_relaxed); }
+
+private:
+    void flushLoop();
+    void drain();
+
+    std::vector<MemoryEvent> buffer;
+    uint64_t mask = 0;
+    std::atomic<uint64_t> head{0}; // Próximo evento a escribir en el buffer (productor)
+    std::atomic<uint64_t> tail{0}; // Próximo evento a escribir en el archivo (hilo)
+    std::atomic<uint64_t> writtenEvents{0};
+    std::atomic<uint64_t> droppedEvents{0};
+    std::atomic<bool> running{false};
+    std::chrono::steady_clock::time_point startTime;
+    std::string tracePath;
+    FILE* file = nullptr;
+    std::thread flusher;
+    std::mutex wakeMutex;
+    std::condition_variable wakeup;
+    bool stopRequested = false;
+};
+
+// Función para leer una traza completa para analizarla
+bool readMemoryTrace(const std::string& path, std::vector<MemoryEvent>& events);
+bool writeMemoryTraceCsv(const std::string& path, const std::vector<MemoryEvent>& events);
+const char* memoryEventTypeName(uint8_t type);
+
+#endif // MEMORY_TRACE_H
@@ -0,0 +1,370 @@
+#include "SharedMemoryTable.h"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+static const uint32_t SHARED_MAGIC = 0x4d454d53; // "SMEM"
+static const uint32_t SHARED_VERSION = 3;
+
+SharedMemoryTable::~SharedMemoryTable()
+{
+    if (isOpen())
+    {
+        close();
+    }
+}
+
+static int64_t currentProcessId()
+{
+#ifdef _WIN32
+    return static_cast<int64_t>(GetCurrentProcessId());
+#else
+    return static_cast<int64_t>(getpid());
+#endif
+}
+
+// Un pid que reutilizó otro programa cuenta como vivo: el segmento no se elimina y el
+// estado sigue en él, que es el error que no pierde nada
+static bool processAlive(int64_t pid)
+{
+#ifdef _WIN32
+    HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, static_cast<DWORD>(pid));
+    if (process == nullptr)
+    {
+        return GetLastError() == ERROR_ACCESS_DENIED;
+    }
+    DWORD exitCode = 0;
+    bool alive = GetExitCodeProcess(process, &exitCode) && exitCode == STILL_ACTIVE;
+    CloseHandle(process);
+    return alive;
+#else
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+// Quita de la lista a los procesos que terminaron sin desconectarse y recalcula attached
+static void pruneProcesses(SharedHeader *header)
+{
+    uint32_t count = 0;
+    for (auto &pid : header->pids)
+    {
+        if (pid != 0 && !processAlive(pid))
+        {
+            pid = 0;
+        }
+        if (pid != 0)
+        {
+            count++;
+        }
+    }
+    header->attached.store(count);
+}
+
+// Espera a que el proceso que creó el segmento termine de inicializarlo
+static bool waitForPublish(SharedHeader *header)
+{
+    for (int i = 0; i < 500; ++i)
+    {
+        if (reinterpret_cast<volatile uint32_t &>(header->magic) == SHARED_MAGIC)
+        {
+            atomic_thread_fence(memory_order_acquire);
+            return header->version == SHARED_VERSION;
+        }
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    return false;
+}
+
+bool SharedMemoryTable::open(const string &segmentName, uint32_t ramFrames, uint32_t swapFrames,
+                             uint32_t tablesCapacity, bool &created)
+{
+    size_t size = sizeof(SharedHeader) + (static_cast<size_t>(ramFrames) + swapFrames) * sizeof(SharedFrame) + tablesCapacity;
+    created = false;
+
+#ifdef _WIN32
+    name = "Local\\" + segmentName;
+    mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                 static_cast<DWORD>(static_cast<uint64_t>(size) >> 32),
+                                 static_cast<DWORD>(size & 0xffffffffu), name.c_str());
+    if (mapping == nullptr)
+    {
+        cerr << "No se pudo crear la memoria compartida: " << name << endl;
+        return false;
+    }
+    created = GetLastError() != ERROR_ALREADY_EXISTS;
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (view == nullptr)
+    {
+        cerr << "No se pudo mapear la memoria compartida: " << name << endl;
+        CloseHandle(mapping);
+        mapping = nullptr;
+        return false;
+    }
+
+    writerMutex = CreateMutexA(nullptr, FALSE, (name + "_writer").c_str());
+    if (created)
+    {
+        header = new (view) SharedHeader();
+    }
+    else
+    {
+        header = static_cast<SharedHeader *>(view);
+    }
+    mappedSize = size;
+#else
+    name = "/" + segmentName;
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0666);
+    if (fd >= 0)
+    {
+        created = true;
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            cerr << "No se pudo dimensionar la memoria compartida: " << name << endl;
+            ::close(fd);
+            shm_unlink(name.c_str());
+            return false;
+        }
+    }
+    else if (errno == EEXIST)
+    {
+        fd = shm_open(name.c_str(), O_RDWR, 0666);
+        // El creador puede no haber fijado todavía el tamaño
+        struct stat info;
+        for (int i = 0; i < 500 && fd >= 0 && fstat(fd, &info) == 0 && info.st_size == 0; ++i)
+        {
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+        if (fd >= 0 && fstat(fd, &info) == 0)
+        {
+            size = static_cast<size_t>(info.st_size);
+        }
+    }
+    if (fd < 0)
+    {
+        cerr << "No se pudo abrir la memoria compartida: " << name << endl;
+        return false;
+    }
+
+    void *view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED)
+    {
+        cerr << "No se pudo mapear la memoria compartida: " << name << endl;
+        if (created)
+        {
+            shm_unlink(name.c_str());
+        }
+        return false;
+    }
+
+    if (created)
+    {
+        header = new (view) SharedHeader();
+        pthread_mutexattr_t attributes;
+        pthread_mutexattr_init(&attributes);
+        pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+        pthread_mutex_init(&header->writer, &attributes);
+        pthread_mutexattr_destroy(&attributes);
+    }
+    else
+    {
+        header = static_cast<SharedHeader *>(view);
+    }
+    mappedSize = size;
+#endif
+
+    if (created)
+    {
+        header->sequence.store(0);
+        header->attached.store(1);
+        header->removed = 0;
+        for (auto &pid : header->pids)
+        {
+            pid = 0;
+        }
+        header->pids[0] = currentProcessId();
+        header->ram_frames = ramFrames;
+        header->swap_frames = swapFrames;
+        header->tables_capacity = tablesCapacity;
+        header->tables_size = 0;
+        return true;
+    }
+
+    if (!waitForPublish(header))
+    {
+        cerr << "La memoria compartida " << name << " no tiene un formato válido" << endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void SharedMemoryTable::publish()
+{
+    header->version = SHARED_VERSION;
+    atomic_thread_fence(memory_order_release);
+    reinterpret_cast<volatile uint32_t &>(header->magic) = SHARED_MAGIC;
+}
+
+bool SharedMemoryTable::attach()
+{
+    if (header->removed)
+    {
+        return false;
+    }
+    pruneProcesses(header);
+    for (auto &pid : header->pids)
+    {
+        if (pid == 0)
+        {
+            pid = currentProcessId();
+            header->attached.fetch_add(1);
+            return true;
+        }
+    }
+    cerr << "La memoria compartida " << name << " ya tiene " << SHARED_MAX_PROCESSES << " procesos conectados" << endl;
+    return false;
+}
+
+bool SharedMemoryTable::detach()
+{
+    int64_t self = currentProcessId();
+    for (auto &pid : header->pids)
+    {
+        if (pid == self)
+        {
+            pid = 0;
+        }
+    }
+    pruneProcesses(header);
+    return header->attached.load() == 0;
+}
+
+void SharedMemoryTable::remove()
+{
+    // Un proceso que ya lo abrió pero no se registró ve removed y abre uno nuevo
+    header->removed = 1;
+#ifndef _WIN32
+    shm_unlink(name.c_str());
+#endif
+}
+
+void SharedMemoryTable::close()
+{
+    if (header == nullptr)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    // Windows elimina el segmento al cerrarse el último handle
+    UnmapViewOfFile(header);
+    CloseHandle(mapping);
+    if (writerMutex != nullptr)
+    {
+        CloseHandle(writerMutex);
+    }
+    mapping = nullptr;
+    writerMutex = nullptr;
+#else
+    munmap(header, mappedSize);
+#endif
+    header = nullptr;
+    mappedSize = 0;
+}
+
+bool SharedMemoryTable::lock()
+{
+#ifdef _WIN32
+    // WAIT_ABANDONED también entrega el mutex si el dueño anterior terminó sin soltarlo
+    bool ownerDied = WaitForSingleObject(writerMutex, INFINITE) == WAIT_ABANDONED;
+#else
+    bool ownerDied = pthread_mutex_lock(&header->writer) == EOWNERDEAD;
+    if (ownerDied)
+    {
+        pthread_mutex_consistent(&header->writer);
+    }
+#endif
+    // Con la secuencia impar los lectores esperarían para siempre y el próximo escritor la
+    // dejaría impar al terminar
+    if (ownerDied && (header->sequence.load(memory_order_relaxed) & 1))
+    {
+        header->sequence.fetch_add(1, memory_order_release);
+        return false;
+    }
+    return true;
+}
+
+void SharedMemoryTable::unlock()
+{
+#ifdef _WIN32
+    ReleaseMutex(writerMutex);
+#else
+    pthread_mutex_unlock(&header->writer);
+#endif
+}
+
+void SharedMemoryTable::beginWrite()
+{
+    header->sequence.fetch_add(1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+void SharedMemoryTable::endWrite()
+{
+    atomic_thread_fence(memory_order_release);
+    header->sequence.fetch_add(1, memory_order_relaxed);
+}
+
+bool SharedMemoryTable::beginRead(uint32_t &sequence) const
+{
+    // Si un escritor está en medio de una modificación (impar) se espera a que termine
+    auto deadline = chrono::steady_clock::now() + chrono::milliseconds(100);
+    while ((sequence = header->sequence.load(memory_order_acquire)) & 1)
+    {
+        if (chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        this_thread::yield();
+    }
+    return true;
+}
+
+bool SharedMemoryTable::validateRead(uint32_t sequence) const
+{
+    atomic_thread_fence(memory_order_acquire);
+    return header->sequence.load(memory_order_relaxed) == sequence;
+}
+
+SharedFrame *SharedMemoryTable::ramFrames()
+{
+    return reinterpret_cast<SharedFrame *>(header + 1);
+}
+
+SharedFrame *SharedMemoryTable::swapFrames()
+{
+    return ramFrames() + header->ram_frames;
+}
+
+uint8_t *SharedMemoryTable::tables()
+{
+    return reinterpret_cast<uint8_t *>(swapFrames() + header->swap_frames);
+}
@@ -0,0 +1,99 @@
+#ifndef SHARED_MEMORY_TABLE_H
+#define SHARED_MEMORY_TABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+static const int SHARED_CONTENT_SIZE = 64; // Bytes de contenido por frame (una página ocupa 50)
+static const int SHARED_MAX_PROCESSES = 64; // Procesos conectados a la vez como máximo
+
+// Frame tal como se guarda en la memoria compartida
+struct SharedFrame {
+    int32_t frame_number;
+    int32_t page_number;
+    int32_t process_id;
+    int32_t segment_id;
+    uint8_t is_free;
+    uint8_t content_length;
+    char content[SHARED_CONTENT_SIZE];
+};
+
+// Cabecera del segmento. Detrás van los frames de RAM, los de Swap y el bloque con las
+// tablas de páginas serializadas.
+struct SharedHeader {
+    uint32_t magic;
+    uint32_t version;
+    std::atomic<uint32_t> sequence;   // Seqlock: impar mientras un escritor modifica el segmento
+    std::atomic<uint32_t> attached;   // Procesos conectados (los de pids)
+    uint32_t removed;                 // El último proceso guardó los JSON y eliminó el segmento
+    uint32_t ram_frames;
+    uint32_t swap_frames;
+    uint32_t tables_capacity;
+    uint32_t tables_size;
+    int64_t pids[SHARED_MAX_PROCESSES]; // Procesos conectados; 0 es un lugar libre
+#ifndef _WIN32
+    pthread_mutex_t writer;           // Mutex compartido entre procesos
+#endif
+};
+
+// Segmento de memoria compartida con la tabla de frames y las tablas de páginas, para
+// que la CLI y la GUI vean el mismo estado sin leer ni escribir los JSON.
+// Lectores: beginRead / copiar / validateRead, reintentando si hubo una escritura.
+// Escritores: lock, beginWrite / modificar / endWrite, unlock.
+class SharedMemoryTable {
+public:
+    ~SharedMemoryTable();
+
+    // Crea el segmento con el tamaño dado o se conecta a uno existente con ese nombre.
+    // created indica si este proceso lo creó: debe llenarlo y llamar a publish(); mientras
+    // tanto los demás procesos que se conectan esperan.
+    bool open(const std::string& name, uint32_t ramFrames, uint32_t swapFrames,
+              uint32_t tablesCapacity, bool& created);
+    // Se desconecta sin eliminar el segmento
+    void close();
+    bool isOpen() const { return header != nullptr; }
+
+    // Con el mutex de escritores tomado. attach registra a un proceso que abrió un segmento
+    // existente y devuelve false si ese segmento ya se eliminó (hay que abrir uno nuevo) o no
+    // hay lugar; detach lo quita y devuelve true si era el último. Los dos descartan antes a
+    // los procesos que terminaron sin desconectarse. remove elimina el segmento.
+    bool attach();
+    bool detach();
+    void remove();
+
+    // Toma el mutex de escritores. Si el dueño anterior terminó sin soltarlo en medio de una
+    // escritura deja la secuencia par otra vez y devuelve false: el contenido puede estar a medias.
+    bool lock();
+    void unlock();
+    void beginWrite();
+    void endWrite();
+    // Espera a que no haya una escritura a medias. Devuelve false si la secuencia sigue impar
+    // después de esperar: el escritor puede haber terminado sin soltar el mutex y hay que
+    // tomarlo (lock) para recuperar el segmento.
+    bool beginRead(uint32_t& sequence) const;
+    bool validateRead(uint32_t sequence) const;
+
+    // Marca el segmento como inicializado; los demás procesos esperan a que lo esté
+    void publish();
+
+    SharedHeader* getHeader() { return header; }
+    SharedFrame* ramFrames();
+    SharedFrame* swapFrames();
+    uint8_t* tables();
+
+private:
+    std::string name;
+    SharedHeader* header = nullptr;
+    size_t mappedSize = 0;
+#ifdef _WIN32
+    void* mapping = nullptr;
+    void* writerMutex = nullptr;
+#endif
+};
+
+#endif // SHARED_MEMORY_TABLE_H
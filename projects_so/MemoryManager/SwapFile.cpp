@@ -0,0 +1,250 @@
+#include "SwapFile.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <malloc.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+SwapFile::~SwapFile()
+{
+    close();
+#ifdef _WIN32
+    _aligned_free(buffer);
+#else
+    free(buffer);
+#endif
+}
+
+// Función para abrir el archivo con o sin E/S directa y dejarlo del tamaño pedido
+bool SwapFile::openFile(uint64_t size, bool direct, bool &created)
+{
+#ifdef _WIN32
+    DWORD flags = FILE_ATTRIBUTE_NORMAL | (direct ? FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH : 0);
+    HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                              nullptr, OPEN_ALWAYS, flags, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER current;
+    if (!GetFileSizeEx(file, &current))
+    {
+        CloseHandle(file);
+        return false;
+    }
+    created = current.QuadPart == 0;
+    if (static_cast<uint64_t>(current.QuadPart) < size)
+    {
+        LARGE_INTEGER end;
+        end.QuadPart = static_cast<LONGLONG>(size);
+        if (!SetFilePointerEx(file, end, nullptr, FILE_BEGIN) || !SetEndOfFile(file))
+        {
+            CloseHandle(file);
+            return false;
+        }
+    }
+    handle = file;
+    return true;
+#else
+    int flags = O_RDWR | O_CREAT;
+#ifdef O_DIRECT
+    if (direct)
+    {
+        flags |= O_DIRECT;
+    }
+#else
+    if (direct)
+    {
+        return false;
+    }
+#endif
+    int file = ::open(filePath.c_str(), flags, 0644);
+    if (file < 0)
+    {
+        return false;
+    }
+    struct stat info;
+    if (fstat(file, &info) != 0)
+    {
+        ::close(file);
+        return false;
+    }
+    created = info.st_size == 0;
+    if (static_cast<uint64_t>(info.st_size) < size && ftruncate(file, static_cast<off_t>(size)) != 0)
+    {
+        ::close(file);
+        return false;
+    }
+    fd = file;
+    return true;
+#endif
+}
+
+bool SwapFile::open(const string &path, uint32_t slots, bool direct, bool &created)
+{
+    close();
+    if (!reserveBuffer(SWAP_SLOT_SIZE))
+    {
+        return false;
+    }
+
+    uint64_t size = static_cast<uint64_t>(slots) * SWAP_SLOT_SIZE;
+    filePath = path;
+    slotCount = slots;
+    directIO = direct;
+    bool opened = openFile(size, direct, created);
+    // Si el sistema de archivos no admite E/S directa (al abrir o al leer un slot alineado)
+    // se vuelve a abrir con E/S normal
+    if (direct && (!opened || (slots > 0 && !transfer(0, SWAP_SLOT_SIZE, false))))
+    {
+        cerr << "E/S directa no disponible para " << path << ", se usa E/S normal" << endl;
+        close();
+        filePath = path;
+        slotCount = slots;
+        directIO = false;
+        opened = openFile(size, false, created);
+    }
+    if (!opened)
+    {
+        cerr << "No se pudo abrir el archivo de Swap: " << path << endl;
+        slotCount = 0;
+        return false;
+    }
+    return true;
+}
+
+void SwapFile::close()
+{
+#ifdef _WIN32
+    if (handle != nullptr)
+    {
+        CloseHandle(handle);
+        handle = nullptr;
+    }
+#else
+    if (fd >= 0)
+    {
+        ::close(fd);
+        fd = -1;
+    }
+#endif
+    slotCount = 0;
+}
+
+bool SwapFile::isOpen() const
+{
+#ifdef _WIN32
+    return handle != nullptr;
+#else
+    return fd >= 0;
+#endif
+}
+
+bool SwapFile::reserveBuffer(size_t size)
+{
+    if (size <= bufferSize)
+    {
+        return true;
+    }
+#ifdef _WIN32
+    _aligned_free(buffer);
+    buffer = static_cast<uint8_t *>(_aligned_malloc(size, SWAP_SLOT_SIZE));
+#else
+    free(buffer);
+    void *memory = nullptr;
+    buffer = posix_memalign(&memory, SWAP_SLOT_SIZE, size) == 0 ? static_cast<uint8_t *>(memory) : nullptr;
+#endif
+    bufferSize = buffer != nullptr ? size : 0;
+    return buffer != nullptr;
+}
+
+// Función para leer o escribir size bytes del buffer en offset con una sola llamada
+bool SwapFile::transfer(uint64_t offset, size_t size, bool writing)
+{
+#ifdef _WIN32
+    OVERLAPPED position = {};
+    position.Offset = static_cast<DWORD>(offset & 0xffffffffu);
+    position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD done = 0;
+    BOOL ok = writing ? WriteFile(handle, buffer, static_cast<DWORD>(size), &done, &position)
+                      : ReadFile(handle, buffer, static_cast<DWORD>(size), &done, &position);
+    return ok && done == size;
+#else
+    ssize_t done = writing ? pwrite(fd, buffer, size, static_cast<off_t>(offset))
+                           : pread(fd, buffer, size, static_cast<off_t>(offset));
+    return done == static_cast<ssize_t>(size);
+#endif
+}
+
+// Función para sacar el contenido de un slot ya leído en el buffer
+static string decodeSlot(const uint8_t *slot)
+{
+    size_t length = min<size_t>(slot[0] | (slot[1] << 8), SWAP_SLOT_CAPACITY);
+    return string(reinterpret_cast<const char *>(slot + 2), length);
+}
+
+bool SwapFile::read(uint32_t slot, string &content)
+{
+    if (!isOpen() || slot >= slotCount || !transfer(static_cast<uint64_t>(slot) * SWAP_SLOT_SIZE, SWAP_SLOT_SIZE, false))
+    {
+        cerr << "No se pudo leer el slot de Swap " << slot << endl;
+        return false;
+    }
+    content = decodeSlot(buffer);
+    return true;
+}
+
+bool SwapFile::readRange(uint32_t first, uint32_t count, vector<string> &contents)
+{
+    if (!isOpen() || first >= slotCount || count == 0)
+    {
+        return false;
+    }
+    count = min(count, slotCount - first);
+    size_t size = static_cast<size_t>(count) * SWAP_SLOT_SIZE;
+    if (!reserveBuffer(size) || !transfer(static_cast<uint64_t>(first) * SWAP_SLOT_SIZE, size, false))
+    {
+        cerr << "No se pudieron leer los slots de Swap " << first << "-" << first + count - 1 << endl;
+        return false;
+    }
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        contents.push_back(decodeSlot(buffer + static_cast<size_t>(i) * SWAP_SLOT_SIZE));
+    }
+    return true;
+}
+
+bool SwapFile::write(uint32_t slot, const string &content)
+{
+    if (content.size() > SWAP_SLOT_CAPACITY)
+    {
+        cerr << "El contenido no cabe en un slot de Swap: " << content.size() << " bytes" << endl;
+        return false;
+    }
+    if (!isOpen() || slot >= slotCount)
+    {
+        cerr << "Slot de Swap inválido: " << slot << endl;
+        return false;
+    }
+
+    memset(buffer, 0, SWAP_SLOT_SIZE);
+    buffer[0] = static_cast<uint8_t>(content.size() & 0xff);
+    buffer[1] = static_cast<uint8_t>(content.size() >> 8);
+    memcpy(buffer + 2, content.data(), content.size());
+    if (!transfer(static_cast<uint64_t>(slot) * SWAP_SLOT_SIZE, SWAP_SLOT_SIZE, true))
+    {
+        cerr << "No se pudo escribir el slot de Swap " << slot << endl;
+        return false;
+    }
+    return true;
+}
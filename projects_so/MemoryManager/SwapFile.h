@@ -0,0 +1,56 @@
+#ifndef SWAP_FILE_H
+#define SWAP_FILE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Tamaño de un slot: un sector. Así con E/S directa cada slot es una lectura o escritura
+// alineada y un slot nunca queda escrito a medias entre dos sectores. Los primeros 2 bytes
+// guardan la longitud del contenido.
+static const uint32_t SWAP_SLOT_SIZE = 512;
+static const uint32_t SWAP_SLOT_CAPACITY = SWAP_SLOT_SIZE - 2;
+
+// Archivo de Swap preasignado con slots de tamaño fijo. El slot i está en el offset
+// i * SWAP_SLOT_SIZE, así leer o escribir una página es una sola E/S posicional (pread/pwrite,
+// o ReadFile/WriteFile con OVERLAPPED en Windows) sin importar el tamaño de la Swap.
+// Con E/S directa (O_DIRECT / FILE_FLAG_NO_BUFFERING) se evita la caché del sistema; si el
+// sistema de archivos no la admite se usa E/S normal. No es seguro usar la misma instancia
+// desde varios hilos a la vez: MemoryManager la usa siempre con memoryMutex tomado.
+class SwapFile {
+public:
+    ~SwapFile();
+
+    // Abre o crea el archivo con el número de slots dado. created indica si el archivo no
+    // existía o estaba vacío.
+    bool open(const std::string& path, uint32_t slots, bool direct, bool& created);
+    void close();
+    bool isOpen() const;
+
+    bool read(uint32_t slot, std::string& content);
+    // Lee count slots contiguos con una sola E/S
+    bool readRange(uint32_t first, uint32_t count, std::vector<std::string>& contents);
+    bool write(uint32_t slot, const std::string& content);
+
+    const std::string& path() const { return filePath; }
+    uint32_t slots() const { return slotCount; }
+    bool direct() const { return directIO; }
+
+private:
+    bool openFile(uint64_t size, bool direct, bool& created);
+    bool reserveBuffer(size_t size);
+    bool transfer(uint64_t offset, size_t size, bool writing);
+
+    std::string filePath;
+    uint32_t slotCount = 0;
+    bool directIO = false;
+    uint8_t* buffer = nullptr; // Alineado a SWAP_SLOT_SIZE, como pide la E/S directa
+    size_t bufferSize = 0;
+#ifdef _WIN32
+    void* handle = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+#endif // SWAP_FILE_H
@@ -6,6 +6,8 @@
 #include <iomanip>
 #include "../projects_so/DeviceManager/DeviceManager.h"
 #include "../projects_so/MemoryManager/MemoryManager.h"
+#include "../projects_so/MemoryManager/MemorySimulator.h"
+#include "../projects_so/MemoryManager/MemoryTrace.h"
 #include "../projects_so/ProcessManager/ProcessManager.h"
 #include "../projects_so/FileSystemManager/FileSystemManager.h"
 
@@ -27,6 +29,19 @@ private:
         return tokens;
     }
 
+    // Divide una lista separada por comas ("8,16,32")
+    std::vector<std::string> splitList(const std::string& list) {
+        std::vector<std::string> items;
+        std::stringstream ss(list);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            if (!item.empty()) {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+
     void displayPrompt() {
         std::cout << currentPath << "> ";
     }
@@ -123,6 +138,27 @@ private:
                 std::cout << "Error al asignar memoria\n";
             }
         }
+        else if (operation == "allocate-batch") {
+            if (tokens.size() < 3) {
+                std::cout << "Uso: memory allocate-batch <process_id>[:<ruta_programa>] ...\n";
+                return;
+            }
+            std::vector<AllocationRequest> requests;
+            for (size_t i = 2; i < tokens.size(); ++i) {
+                size_t separator = tokens[i].find(':');
+                AllocationRequest request;
+                request.process_id = std::stoi(tokens[i].substr(0, separator));
+                if (separator != std::string::npos) {
+                    request.programPath = tokens[i].substr(separator + 1);
+                }
+                requests.push_back(request);
+            }
+            if (allocateBatch(requests)) {
+                std::cout << "Memoria asignada exitosamente para " << requests.size() << " procesos\n";
+            } else {
+                std::cout << "Error al asignar memoria: no se asignó ningún proceso del lote\n";
+            }
+        }
         else if (operation == "free") {
             if (tokens.size() < 3) {
                 std::cout << "Uso: memory free <process_id>\n";
@@ -147,6 +183,578 @@ private:
                 std::cout << "Error al realizar swap\n";
             }
         }
+        else if (operation == "read") {
+            if (tokens.size() < 5) {
+                std::cout << "Uso: memory read <segment_id> <page_number> <process_id>\n";
+                return;
+            }
+            std::string content;
+            if (memoryRead(std::stoi(tokens[2]), std::stoi(tokens[3]), std::stoi(tokens[4]), content)) {
+                std::cout << "Contenido: " << content << "\n";
+            } else {
+                std::cout << "Error al leer la página\n";
+            }
+        }
+        else if (operation == "write") {
+            if (tokens.size() < 6) {
+                std::cout << "Uso: memory write <segment_id> <page_number> <process_id> <datos>\n";
+                return;
+            }
+            if (memoryWrite(std::stoi(tokens[2]), std::stoi(tokens[3]), std::stoi(tokens[4]), tokens[5])) {
+                std::cout << "Página escrita exitosamente\n";
+            } else {
+                std::cout << "Error al escribir la página\n";
+            }
+        }
+        else if (operation == "writeback") {
+            WritebackStats stats = getWritebackStats();
+            std::cout << "Páginas sucias escritas en Swap: " << stats.writebacks << "\n";
+            std::cout << "Escrituras evitadas (páginas limpias): " << stats.writebacks_avoided << "\n";
+            std::cout << "Escrituras evitadas (contenido igual al de Swap): " << stats.writebacks_identical << "\n";
+            std::cout << "Escrituras que no cambiaron la página: " << stats.unchanged_writes << "\n";
+            std::cout << "Caché de Swap: " << stats.cached_pages << " páginas limpias, "
+                      << stats.dirty_pages << " sucias en RAM\n";
+        }
+        else if (operation == "swapinfo") {
+            SwapFragmentation stats = getSwapFragmentation();
+            std::cout << "Slots de Swap libres: " << stats.free_slots << " de " << stats.total_slots << "\n";
+            std::cout << "Bloques libres: " << stats.free_extents
+                      << " (el mayor de " << stats.largest_free_extent << " slots)\n";
+            std::cout << "Fragmentación externa: " << std::fixed << std::setprecision(2)
+                      << stats.external_fragmentation * 100 << " %\n";
+            std::cout << "Segmentos contiguos: " << stats.contiguous_segments << " de " << stats.segments << "\n";
+        }
+        else if (operation == "swapdev") {
+            if (tokens.size() >= 6 && tokens[2] == "add") {
+                if (addSwapDevice(tokens[3], std::stoi(tokens[4]), std::stoi(tokens[5]))) {
+                    std::cout << "Dispositivo de Swap agregado: " << tokens[3] << "\n";
+                }
+                return;
+            }
+            if (tokens.size() >= 4 && tokens[2] == "remove") {
+                if (removeSwapDevice(tokens[3])) {
+                    std::cout << "Dispositivo de Swap quitado: " << tokens[3] << "\n";
+                }
+                return;
+            }
+            if (tokens.size() >= 5 && tokens[2] == "priority") {
+                if (setSwapDevicePriority(tokens[3], std::stoi(tokens[4]))) {
+                    std::cout << "Prioridad actualizada\n";
+                }
+                return;
+            }
+            if (tokens.size() >= 4 && tokens[2] == "direct") {
+                bool enabled = tokens[3] == "on";
+                if (!setSwapDirectIO(enabled) && enabled) {
+                    std::cout << "E/S directa no disponible en todos los dispositivos, se usa E/S normal\n";
+                }
+            }
+            std::cout << "Dispositivo\tPrioridad\tSlots\tUsados\tDirecta\tLecturas\tLect. prom/p99 (us)"
+                      << "\tEscrituras\tEscr. prom/p99 (us)\n";
+            std::cout << std::fixed << std::setprecision(1);
+            for (const auto& device : getSwapDevices()) {
+                std::cout << device.path << "\t" << device.priority << "\t\t" << device.first_slot << "-"
+                          << device.first_slot + device.slots - 1 << "\t" << device.used_slots << "\t"
+                          << (device.direct_io ? "sí" : "no") << "\t" << device.reads << "\t\t"
+                          << device.read_avg_ns / 1000.0 << "/" << device.read_p99_ns / 1000.0 << "\t\t"
+                          << device.writes << "\t\t" << device.write_avg_ns / 1000.0 << "/"
+                          << device.write_p99_ns / 1000.0 << "\n";
+            }
+        }
+        else if (operation == "replay") {
+            if (tokens.size() < 3) {
+                std::cout << "Uso: memory replay <traza> [local|fifo|lru|clock|opt|all] [frames]\n";
+                return;
+            }
+            // "all" corre todas las políticas sobre la misma traza y las compara con OPT
+            std::vector<ReplacementPolicy> policies;
+            std::string policyName = tokens.size() > 3 ? tokens[3] : "local";
+            if (policyName == "all") {
+                policies = {ReplacementPolicy::Local, ReplacementPolicy::FIFO, ReplacementPolicy::LRU,
+                            ReplacementPolicy::Clock, ReplacementPolicy::OPT};
+            } else {
+                ReplacementPolicy policy;
+                if (!parseReplacementPolicy(policyName, policy)) {
+                    std::cout << "Política de reemplazo no válida\n";
+                    return;
+                }
+                policies.push_back(policy);
+            }
+            int ramFrames = tokens.size() > 4 ? std::stoi(tokens[4]) : ramFrameCount();
+
+            std::vector<TraceRecord> records;
+            if (!loadTrace(tokens[2], records)) {
+                std::cout << "Error al leer la traza\n";
+                return;
+            }
+            CompiledTrace trace = compileTrace(records);
+            std::cout << "Accesos: " << trace.pages.size() << " (" << trace.page_count
+                      << " páginas distintas), frames de RAM: " << ramFrames << "\n";
+            std::cout << std::setw(8) << "Política" << " | " << std::setw(12) << "Fallos" << " | "
+                      << std::setw(8) << "% fallos" << " | " << std::setw(12) << "Desalojos" << " | "
+                      << std::setw(12) << "Escrituras" << " | " << std::setw(10) << "M acc/s" << "\n";
+            std::cout << std::string(75, '-') << "\n";
+
+            for (ReplacementPolicy policy : policies) {
+                SimulationConfig config;
+                config.policy = policy;
+                config.ram_frames = ramFrames;
+                MemorySimulator simulator(config);
+                SimulationResult result = simulator.run(trace);
+                std::cout << std::setw(8) << replacementPolicyName(policy) << " | "
+                          << std::setw(12) << result.faults << " | " << std::fixed << std::setprecision(2)
+                          << std::setw(8) << (result.accesses ? 100.0 * result.faults / result.accesses : 0.0) << " | "
+                          << std::setw(12) << result.evictions << " | " << std::setw(12) << result.writebacks << " | "
+                          << std::setprecision(1) << std::setw(10) << result.accesses_per_second / 1e6 << "\n";
+            }
+        }
+        else if (operation == "sweep") {
+            if (tokens.size() < 4) {
+                std::cout << "Uso: memory sweep <traza> <salida.csv> [politicas] [frames] [tamaños_pagina] [hilos]\n";
+                return;
+            }
+            std::vector<ReplacementPolicy> policies;
+            for (const auto& name : splitList(tokens.size() > 4 ? tokens[4] : "local,fifo,lru,clock,opt")) {
+                ReplacementPolicy policy;
+                if (!parseReplacementPolicy(name, policy)) {
+                    std::cout << "Política de reemplazo no válida: " << name << "\n";
+                    return;
+                }
+                policies.push_back(policy);
+            }
+            std::vector<int> ramFrames;
+            for (const auto& value : splitList(tokens.size() > 5 ? tokens[5] : std::to_string(ramFrameCount()))) {
+                ramFrames.push_back(std::stoi(value));
+            }
+            std::vector<int> pageSizes;
+            for (const auto& value : splitList(tokens.size() > 6 ? tokens[6] : std::to_string(TRACE_PAGE_SIZE))) {
+                int pageSize = std::stoi(value);
+                if (pageSize <= 0 || pageSize % TRACE_PAGE_SIZE != 0) {
+                    std::cout << "El tamaño de página debe ser múltiplo de " << TRACE_PAGE_SIZE << ": " << value << "\n";
+                    return;
+                }
+                pageSizes.push_back(pageSize);
+            }
+            int threads = tokens.size() > 7 ? std::stoi(tokens[7]) : 0;
+
+            std::vector<TraceRecord> records;
+            if (!loadTrace(tokens[2], records)) {
+                std::cout << "Error al leer la traza\n";
+                return;
+            }
+            auto points = runSweep(records, policies, ramFrames, pageSizes, threads);
+            if (writeSweepCsv(tokens[3], points)) {
+                std::cout << "Barrido de " << points.size() << " configuraciones guardado en " << tokens[3] << "\n";
+            } else {
+                std::cout << "Error al guardar el barrido\n";
+            }
+        }
+        else if (operation == "mrc") {
+            if (tokens.size() < 3) {
+                std::cout << "Uso: memory mrc <traza> [max_frames] [muestreo]\n";
+                return;
+            }
+            int maxFrames = tokens.size() > 3 ? std::stoi(tokens[3]) : 4 * ramFrameCount();
+            double sampling = tokens.size() > 4 ? std::stod(tokens[4]) : 1.0;
+
+            std::vector<TraceRecord> records;
+            if (!loadTrace(tokens[2], records)) {
+                std::cout << "Error al leer la traza\n";
+                return;
+            }
+            MissRatioCurve curve = lruMissRatioCurve(compileTrace(records), maxFrames, sampling);
+            std::cout << "Accesos analizados: " << curve.accesses << ", fallos obligatorios: " << curve.cold_misses
+                      << " (" << std::fixed << std::setprecision(3) << curve.seconds << " s)\n";
+            std::cout << std::setw(10) << "Frames" << " | " << std::setw(10) << "% fallos" << "\n";
+            std::cout << std::string(25, '-') << "\n";
+            // Potencias de dos y el máximo pedido
+            for (int frames = 1; frames <= maxFrames; frames = frames < maxFrames && frames * 2 > maxFrames ? maxFrames : frames * 2) {
+                std::cout << std::setw(10) << frames << " | " << std::setprecision(2) << std::setw(10)
+                          << curve.miss_ratio[frames] * 100 << "\n";
+                if (frames == maxFrames) {
+                    break;
+                }
+            }
+        }
+        else if (operation == "bench-load") {
+            int frames = tokens.size() > 2 ? std::stoi(tokens[2]) : 1000000;
+            FrameLoadBenchmark result = benchmarkFrameLoad(frames, "./frames_benchmark.json");
+            if (!result.ok) {
+                std::cout << "Error en la prueba de carga\n";
+                return;
+            }
+            std::cout << "Carga de una imagen de " << result.frames << " frames:\n";
+            std::cout << "  DOM: " << std::fixed << std::setprecision(3) << result.dom_seconds << " s\n";
+            std::cout << "  SAX: " << result.sax_seconds << " s\n";
+        }
+        else if (operation == "bench-translate") {
+            int count = tokens.size() > 2 ? std::stoi(tokens[2]) : 10000000;
+            int size = tokens.size() > 3 ? std::stoi(tokens[3]) : 50;
+            AddressTranslationBenchmark result = benchmarkAddressTranslation(count, size);
+            if (!result.ok) {
+                std::cout << "Error en la prueba de traducción\n";
+                return;
+            }
+            std::cout << "Traducción de " << result.addresses << " direcciones con páginas de " << result.page_size << ":\n";
+            std::cout << "  Especializada: " << std::fixed << std::setprecision(3) << result.specialized_seconds << " s"
+                      << (result.specialized ? "" : " (sin especialización para este tamaño)") << "\n";
+            std::cout << "  Genérica: " << result.generic_seconds << " s\n";
+        }
+        else if (operation == "readaddr") {
+            if (tokens.size() < 4) {
+                std::cout << "Uso: memory readaddr <process_id> <direccion>\n";
+                return;
+            }
+            uint64_t address = std::stoull(tokens[3], nullptr, 0);
+            VirtualAddress parts = translateAddress(address);
+            std::cout << "Segmento " << parts.segment << ", página " << parts.page + 1
+                      << ", desplazamiento " << parts.offset << "\n";
+            std::string content;
+            if (memoryReadAddress(std::stoi(tokens[2]), address, content)) {
+                std::cout << content << "\n";
+            }
+        }
+        else if (operation == "top") {
+            std::vector<ProcessMemoryUsage> report = getProcessMemoryReport();
+            size_t limit = tokens.size() > 2 ? static_cast<size_t>(std::stoi(tokens[2])) : report.size();
+            if (report.empty()) {
+                std::cout << "No hay procesos en memoria\n";
+                return;
+            }
+            std::cout << "PID\tRAM\tSwap\tCompartida RAM\tCompartida Swap\tPSS (KB)\tEstado\n";
+            std::cout << std::fixed << std::setprecision(1);
+            for (size_t i = 0; i < report.size() && i < limit; ++i) {
+                const auto& usage = report[i];
+                std::cout << usage.process_id << "\t" << usage.ram_frames << "\t" << usage.swap_frames << "\t"
+                          << usage.shared_ram_frames << "\t\t" << usage.shared_swap_frames << "\t\t"
+                          << usage.proportional_kb << "\t\t" << (usage.suspended ? "suspendido" : "activo") << "\n";
+            }
+        }
+        else if (operation == "ws") {
+            std::vector<WorkingSetInfo> sets = getWorkingSets();
+            if (sets.empty()) {
+                std::cout << "No hay procesos en memoria\n";
+                return;
+            }
+            std::cout << "PID\tResidentes\tWorking set\tPresupuesto\tReferencias\tFallos\n";
+            for (const auto& set : sets) {
+                std::cout << set.process_id << "\t" << set.resident_pages << "\t\t" << set.working_set
+                          << "\t\t" << set.frame_budget << "\t\t" << set.references << "\t\t"
+                          << set.faults << "\n";
+            }
+        }
+        else if (operation == "pff") {
+            if (tokens.size() < 3) {
+                std::cout << "Uso: memory pff <on|off|status|params> [ventana] [crecer] [achicar] [min] [max]\n";
+                return;
+            }
+            PFFConfig config = getPFFConfig();
+            if (tokens[2] == "on" || tokens[2] == "off") {
+                config.enabled = tokens[2] == "on";
+                setPFFConfig(config);
+                std::cout << "Control de frecuencia de fallos " << (config.enabled ? "activado" : "desactivado") << "\n";
+            }
+            else if (tokens[2] == "params") {
+                if (tokens.size() < 6) {
+                    std::cout << "Uso: memory pff params <ventana> <crecer> <achicar> [min] [max]\n";
+                    return;
+                }
+                config.window = std::stoi(tokens[3]);
+                config.grow_interval = std::stoi(tokens[4]);
+                config.shrink_interval = std::stoi(tokens[5]);
+                if (tokens.size() > 6) {
+                    config.min_frames = std::stoi(tokens[6]);
+                }
+                if (tokens.size() > 7) {
+                    config.max_frames = std::stoi(tokens[7]);
+                }
+                setPFFConfig(config);
+                std::cout << "Parámetros actualizados\n";
+            }
+            else if (tokens[2] == "status") {
+                std::cout << "PFF: " << (config.enabled ? "activo" : "inactivo") << "\n";
+                std::cout << "Ventana del working set: " << config.window << " referencias\n";
+                std::cout << "Crece con fallos cada <= " << config.grow_interval << " referencias, se achica con >= "
+                          << config.shrink_interval << "\n";
+                std::cout << "Presupuesto por proceso: " << config.min_frames << " a " << config.max_frames << " frames\n";
+            }
+            else {
+                std::cout << "Operación de PFF no válida\n";
+            }
+        }
+        else if (operation == "thrash") {
+            if (tokens.size() < 3) {
+                std::cout << "Uso: memory thrash <on|off|status|params|priority|resume> ...\n";
+                return;
+            }
+            LoadControlConfig config = getLoadControlConfig();
+            if (tokens[2] == "on" || tokens[2] == "off") {
+                config.enabled = tokens[2] == "on";
+                setLoadControlConfig(config);
+                std::cout << "Control de carga " << (config.enabled ? "activado" : "desactivado") << "\n";
+            }
+            else if (tokens[2] == "params") {
+                if (tokens.size() < 6) {
+                    std::cout << "Uso: memory thrash params <ventana> <proporcion_thrashing> <proporcion_calma>\n";
+                    return;
+                }
+                config.window = std::stoi(tokens[3]);
+                config.thrash_ratio = std::stod(tokens[4]);
+                config.calm_ratio = std::stod(tokens[5]);
+                setLoadControlConfig(config);
+                std::cout << "Parámetros actualizados\n";
+            }
+            else if (tokens[2] == "priority") {
+                if (tokens.size() < 5) {
+                    std::cout << "Uso: memory thrash priority <process_id> <prioridad>\n";
+                    return;
+                }
+                if (setMemoryPriority(std::stoi(tokens[3]), std::stoi(tokens[4]))) {
+                    std::cout << "Prioridad actualizada\n";
+                }
+            }
+            else if (tokens[2] == "resume") {
+                if (tokens.size() < 4) {
+                    std::cout << "Uso: memory thrash resume <process_id>\n";
+                    return;
+                }
+                if (resumeProcessMemory(std::stoi(tokens[3]))) {
+                    std::cout << "Proceso reanudado\n";
+                }
+            }
+            else if (tokens[2] == "status") {
+                ThrashingStats stats = getThrashingStats();
+                std::cout << "Control de carga: " << (config.enabled ? "activo" : "inactivo") << "\n";
+                std::cout << "Estado: " << (stats.thrashing ? "thrashing" : "normal") << " (fallos en la ventana: "
+                          << std::fixed << std::setprecision(2) << stats.fault_ratio * 100 << "%)\n";
+                std::cout << "Episodios: " << stats.episodes << ", total " << stats.total_seconds
+                          << " s, el más largo " << stats.longest_seconds << " s\n";
+                if (stats.thrashing) {
+                    std::cout << "Episodio actual: " << stats.current_seconds << " s\n";
+                }
+                std::cout << "Suspensiones: " << stats.suspensions << ", reanudaciones: " << stats.resumes << "\n";
+                std::cout << "Procesos suspendidos:";
+                for (int pid : stats.suspended) {
+                    std::cout << " " << pid;
+                }
+                std::cout << "\n";
+            }
+            else {
+                std::cout << "Operación de control de carga no válida\n";
+            }
+        }
+        else if (operation == "oom") {
+            OomStats stats = getOomStats();
+            std::cout << "Cargas con desalojo: " << stats.reclaims << ", procesos terminados: " << stats.kills
+                      << ", cargas fallidas: " << stats.failures << "\n";
+            if (stats.last_victim != 0) {
+                std::cout << "Último proceso terminado: " << stats.last_victim << "\n";
+            }
+            std::cout << "Orden de terminación:\nPID\tPrioridad\tRAM\tSwap\n";
+            for (const auto& candidate : getOomRanking()) {
+                std::cout << candidate.process_id << "\t" << candidate.priority << "\t\t" << candidate.ram_frames
+                          << "\t" << candidate.swap_frames << "\n";
+            }
+        }
+        else if (operation == "trace") {
+            if (tokens.size() < 3) {
+                std::cout << "Uso: memory trace <start|stop|status|decode> [archivo] [capacidad|csv]\n";
+                return;
+            }
+            if (tokens[2] == "start") {
+                if (tokens.size() < 4) {
+                    std::cout << "Uso: memory trace start <archivo> [capacidad]\n";
+                    return;
+                }
+                int capacity = tokens.size() > 4 ? std::stoi(tokens[4]) : 65536;
+                if (startMemoryTrace(tokens[3], capacity)) {
+                    std::cout << "Traza de eventos iniciada en " << tokens[3] << "\n";
+                }
+            }
+            else if (tokens[2] == "stop") {
+                stopMemoryTrace();
+                MemoryTraceStatus status = getMemoryTraceStatus();
+                std::cout << "Traza detenida: " << status.written << " eventos escritos, "
+                          << status.dropped << " descartados\n";
+            }
+            else if (tokens[2] == "status") {
+                MemoryTraceStatus status = getMemoryTraceStatus();
+                std::cout << "Traza: " << (status.active ? "activa" : "inactiva");
+                if (!status.path.empty()) {
+                    std::cout << " (" << status.path << ")";
+                }
+                std::cout << "\nEventos: " << status.recorded << " registrados, " << status.written
+                          << " escritos, " << status.dropped << " descartados\n";
+            }
+            else if (tokens[2] == "decode") {
+                if (tokens.size() < 4) {
+                    std::cout << "Uso: memory trace decode <archivo> [csv]\n";
+                    return;
+                }
+                std::vector<MemoryEvent> events;
+                if (!readMemoryTrace(tokens[3], events)) {
+                    return;
+                }
+                if (tokens.size() > 4) {
+                    if (writeMemoryTraceCsv(tokens[4], events)) {
+                        std::cout << events.size() << " eventos guardados en " << tokens[4] << "\n";
+                    }
+                    return;
+                }
+                std::cout << "Tiempo(ms)\tEvento\tPID\tSegmento\tPágina\tFrame\tSlot\n";
+                std::cout << std::fixed << std::setprecision(3);
+                for (const auto& event : events) {
+                    std::cout << event.timestamp_ns / 1e6 << "\t" << memoryEventTypeName(event.type)
+                              << ((event.flags & MEMORY_EVENT_WRITEBACK) ? "*" : "") << "\t" << event.process_id
+                              << "\t" << event.segment_id << "\t\t" << event.page_number << "\t"
+                              << event.ram_frame << "\t" << event.swap_slot << "\n";
+                }
+            }
+            else {
+                std::cout << "Operación de traza no válida\n";
+            }
+        }
+        else if (operation == "stats") {
+            if (tokens.size() > 2 && tokens[2] == "reset") {
+                resetMemoryStats();
+                std::cout << "Estadísticas reiniciadas\n";
+                return;
+            }
+            if (tokens.size() > 2 && tokens[2] == "json") {
+                if (tokens.size() < 4) {
+                    std::cout << "Uso: memory stats json <ruta>\n";
+                    return;
+                }
+                if (exportMemoryStats(tokens[3])) {
+                    std::cout << "Estadísticas guardadas en " << tokens[3] << "\n";
+                }
+                return;
+            }
+            MemoryStats stats = getMemoryStats();
+            std::cout << "Operación\tLlamadas\tBytes\tProm(us)\tp50(us)\tp90(us)\tp99(us)\tMáx(us)\n";
+            std::cout << std::fixed << std::setprecision(1);
+            for (const auto& op : stats.operations) {
+                if (op.count == 0) {
+                    continue;
+                }
+                std::cout << op.name << "\t" << op.count << "\t\t" << op.bytes << "\t"
+                          << op.total_ns / 1000.0 / op.count << "\t\t" << op.p50_ns / 1000.0 << "\t"
+                          << op.p90_ns / 1000.0 << "\t" << op.p99_ns / 1000.0 << "\t"
+                          << op.max_ns / 1000.0 << "\n";
+            }
+            std::cout << "Fallos de página: " << stats.page_faults << "\n";
+            std::cout << "Desalojos: " << stats.evictions << "\n";
+            std::cout << "Bytes traídos de Swap: " << stats.bytes_swapped_in << "\n";
+            std::cout << "Bytes escritos a Swap: " << stats.bytes_written_back << "\n";
+            std::cout << "Páginas leídas por adelantado: " << stats.readahead_pages
+                      << ", usadas en fallos: " << stats.readahead_hits << "\n";
+        }
+        else if (operation == "shared") {
+            std::vector<SharedSegmentInfo> segments = getSharedSegments();
+            if (segments.empty()) {
+                std::cout << "No hay segmentos compartidos\n";
+                return;
+            }
+            std::cout << "Id\tSegmento\tReferencias\tPáginas\tEn RAM\n";
+            for (const auto& segment : segments) {
+                std::cout << segment.shared_id << "\t" << segment.segment_id << "\t\t"
+                          << segment.refcount << "\t\t" << segment.pages << "\t"
+                          << segment.resident_pages << "\n";
+            }
+        }
+        else if (operation == "lazy") {
+            if (tokens.size() > 2 && (tokens[2] == "on" || tokens[2] == "off")) {
+                setLazyAllocation(tokens[2] == "on");
+                std::cout << "Carga perezosa " << (tokens[2] == "on" ? "activada" : "desactivada") << "\n";
+                return;
+            }
+            LazyAllocationStats stats = getLazyAllocationStats();
+            std::cout << "Carga perezosa: " << (stats.enabled ? "activa" : "inactiva") << "\n";
+            std::cout << "Páginas materializadas: " << stats.pages_materialized << "\n";
+            std::cout << "Páginas sin frames: " << stats.pending_pages << "\n";
+        }
+        else if (operation == "cache") {
+            if (tokens.size() > 2 && tokens[2] == "clear") {
+                clearProgramCache();
+                std::cout << "Caché de programas vaciada\n";
+                return;
+            }
+            ProgramCacheStats stats = getProgramCacheStats();
+            std::cout << "Programas en caché: " << stats.entries << "\n";
+            std::cout << "Aciertos (sin leer el archivo): " << stats.hits << "\n";
+            std::cout << "Aciertos por contenido: " << stats.content_hits << "\n";
+            std::cout << "Fallos (lectura y segmentación): " << stats.misses << "\n";
+        }
+        else if (operation == "shm") {
+            if (tokens.size() < 3) {
+                std::cout << "Uso: memory shm <attach|detach|status> [nombre]\n";
+                return;
+            }
+            if (tokens[2] == "attach") {
+                bool ok = tokens.size() > 3 ? attachSharedMemory(tokens[3]) : attachSharedMemory();
+                std::cout << (ok ? "Conectado a la memoria compartida\n" : "Error al conectar la memoria compartida\n");
+            }
+            else if (tokens[2] == "detach") {
+                detachSharedMemory();
+                std::cout << "Desconectado de la memoria compartida\n";
+            }
+            else if (tokens[2] == "status") {
+                SharedMemoryStatus status = getSharedMemoryStatus();
+                if (!status.attached) {
+                    std::cout << "Memoria compartida: desconectada (se usan RAM.json y Swap.json)\n";
+                    return;
+                }
+                std::cout << "Memoria compartida: conectada\n";
+                std::cout << "Procesos conectados: " << status.processes << "\n";
+                std::cout << "Frames: " << status.ram_frames << " RAM, " << status.swap_frames << " Swap\n";
+                std::cout << "Tablas de páginas: " << status.tables_size << " / "
+                          << status.tables_capacity << " bytes\n";
+            }
+            else {
+                std::cout << "Operación de memoria compartida no válida\n";
+            }
+        }
+        else if (operation == "reclaim") {
+            if (tokens.size() < 3) {
+                std::cout << "Uso: memory reclaim <start|stop|status|watermarks> [baja] [alta]\n";
+                return;
+            }
+            if (tokens[2] == "start") {
+                startReclaimer();
+                std::cout << "Reclaimer iniciado\n";
+            }
+            else if (tokens[2] == "stop") {
+                stopReclaimer();
+                std::cout << "Reclaimer detenido\n";
+            }
+            else if (tokens[2] == "watermarks") {
+                if (tokens.size() < 5) {
+                    std::cout << "Uso: memory reclaim watermarks <baja> <alta>\n";
+                    return;
+                }
+                setReclaimWatermarks(std::stoi(tokens[3]), std::stoi(tokens[4]));
+                std::cout << "Marcas de agua actualizadas\n";
+            }
+            else if (tokens[2] == "status") {
+                ReclaimStats stats = getReclaimStats();
+                std::cout << "Reclaimer: " << (stats.running ? "activo" : "detenido") << "\n";
+                std::cout << "Marcas de agua (frames libres): baja " << stats.low_watermark
+                          << ", alta " << stats.high_watermark << "\n";
+                std::cout << "Páginas inspeccionadas: " << stats.pages_scanned << "\n";
+                std::cout << "Páginas desalojadas: " << stats.pages_reclaimed << "\n";
+                std::cout << "Desalojos síncronos: " << stats.stalls << "\n";
+            }
+            else {
+                std::cout << "Operación de reclaimer no válida\n";
+            }
+        }
+        else if (operation == "zero") {
+            ZeroPoolStats stats = getZeroPoolStats();
+            std::cout << "Frames libres y limpios: " << stats.ready_frames << "\n";
+            std::cout << "Frames limpiados al guardar: " << stats.frames_zeroed << "\n";
+            std::cout << "Asignaciones desde el pool: " << stats.pool_hits
+                      << ", reusando un frame recién liberado: " << stats.reused_frames << "\n";
+        }
         else if (operation == "status") {
             int availableMem = freeMem();
             std::cout << "Memoria disponible: " << availableMem << " KB\n";
@@ -397,9 +1005,42 @@ private:
         std::cout << "  device status                                 - Muestra el estado del display\n";
         std::cout << "\nComandos de memoria:\n";
         std::cout << "  memory allocate <process_id>                  - Asigna memoria a un proceso\n";
+        std::cout << "  memory allocate-batch <pid>[:<ruta>] ...      - Asigna memoria a varios procesos (todo o nada)\n";
         std::cout << "  memory free <process_id>                      - Libera la memoria de un proceso\n";
         std::cout << "  memory swap <segment_id> <page> <process_id>  - Realiza swap de una página\n";
+        std::cout << "  memory read <segment_id> <page> <process_id>  - Lee una página (marca referencia)\n";
+        std::cout << "  memory write <segment_id> <page> <pid> <datos> - Escribe una página (marca modificada)\n";
+        std::cout << "  memory writeback                              - Muestra escrituras a Swap evitadas\n";
         std::cout << "  memory status                                 - Muestra el estado de la memoria\n";
+        std::cout << "  memory swapinfo                               - Muestra la fragmentación de la Swap\n";
+        std::cout << "  memory swapdev [direct on|off]                - Uso y latencia de los dispositivos de Swap\n";
+        std::cout << "  memory swapdev add <ruta> <slots> <prioridad> - Agrega un dispositivo con slots de Swap.dat\n";
+        std::cout << "  memory swapdev remove <ruta>|priority <ruta> <p> - Quita un dispositivo o cambia su prioridad\n";
+        std::cout << "  memory replay <traza> [politica|all] [frames] - Simula una traza de accesos\n";
+        std::cout << "  memory sweep <traza> <csv> [pol] [frames] [tam] [hilos] - Barrido de configuraciones\n";
+        std::cout << "  memory mrc <traza> [max_frames] [muestreo]    - Curva de fallos LRU para todo tamaño de RAM\n";
+        std::cout << "  memory bench-load [frames]                    - Compara la carga SAX y DOM de frames\n";
+        std::cout << "  memory readaddr <process_id> <direccion>      - Lee desde una dirección virtual\n";
+        std::cout << "  memory bench-translate [n] [tam_pagina]       - Traducción especializada vs genérica\n";
+        std::cout << "  memory top [n]                                - Procesos ordenados por memoria usada\n";
+        std::cout << "  memory ws                                     - Working set y presupuesto de frames por proceso\n";
+        std::cout << "  memory pff <on|off|status|params ...>         - Asignación de frames por frecuencia de fallos\n";
+        std::cout << "  memory thrash <on|off|status>                 - Detección de thrashing y control de carga\n";
+        std::cout << "  memory thrash params <ventana> <thr> <calma>  - Ajusta el detector de thrashing\n";
+        std::cout << "  memory thrash priority <pid> <prioridad>      - Prioridad frente al control de carga\n";
+        std::cout << "  memory thrash resume <pid>                    - Reanuda un proceso suspendido\n";
+        std::cout << "  memory oom                                    - Procesos terminados por falta de memoria y orden\n";
+        std::cout << "  memory trace start <archivo> [capacidad]      - Graba los eventos de memoria en binario\n";
+        std::cout << "  memory trace stop|status                      - Detiene la traza o muestra su estado\n";
+        std::cout << "  memory trace decode <archivo> [csv]           - Muestra una traza o la pasa a CSV\n";
+        std::cout << "  memory stats [reset|json <ruta>]              - Latencias por operación, fallos y desalojos\n";
+        std::cout << "  memory shared                                 - Lista los segmentos de código compartidos\n";
+        std::cout << "  memory lazy [on|off]                          - Asigna frames en el primer acceso a cada página\n";
+        std::cout << "  memory cache [clear]                          - Muestra o vacía la caché de programas\n";
+        std::cout << "  memory shm <attach|detach|status> [nombre]    - Estado compartido con otras instancias\n";
+        std::cout << "  memory reclaim <start|stop|status>            - Controla el reclaimer de páginas\n";
+        std::cout << "  memory reclaim watermarks <baja> <alta>       - Ajusta las marcas de frames libres\n";
+        std::cout << "  memory zero                                   - Pool de frames libres y limpios\n";
         std::cout << "\nComandos de procesos:\n";
         std::cout << "  process create <ruta_programa> [argumentos]   - Crea un nuevo proceso\n";
         std::cout << "  process list                                  - Lista todos los procesos\n";
@@ -446,8 +1087,13 @@ int main() {
     SetConsoleOutputCP(CP_UTF8);
     SetConsoleCP(CP_UTF8);
 
+    // Comparte la tabla de frames con la GUI y otras instancias de la CLI
+    attachSharedMemory();
+
     CLI cli;
     cli.run();
 
+    detachSharedMemory();
+
     return 0;
 }
\ No newline at end of file